@@ -0,0 +1,127 @@
+#include <span>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <falutez/falutez-codec.hpp>
+
+// representative API payload: an array of flat records with repeating keys
+static std::string make_payload(int64_t records) {
+  std::string payload = "[";
+  for (int64_t idx = 0; idx < records; ++idx) {
+    if (idx != 0)
+      payload += ',';
+    payload += std::format(
+        R"({{"id":{},"name":"user-{}","email":"user-{}@example.com",)"
+        R"("active":{},"balance":{:.2f},"tags":["alpha","beta","gamma"]}})",
+        idx, idx, idx, idx % 3 == 0 ? "true" : "false", idx * 1.37);
+  }
+  payload += ']';
+  return payload;
+}
+
+// arguments: {level, records}; counters report the bytes that would go on the
+// wire so the CPU cost can be weighed against the bandwidth saved
+template <HTTP::ENCODING TEncoding>
+void BM_CODEC_COMPRESS(benchmark::State &state) {
+  auto const payload = make_payload(state.range(1));
+  size_t wire_bytes = 0;
+
+  for (auto _ : state) {
+    auto packed = HTTP::CODEC::compress(TEncoding, payload,
+                                        static_cast<int>(state.range(0)));
+    wire_bytes = packed.value().size();
+    benchmark::DoNotOptimize(packed);
+  }
+
+  state.SetBytesProcessed(state.iterations() * payload.size());
+  state.counters["raw_bytes"] = static_cast<double>(payload.size());
+  state.counters["wire_bytes"] = static_cast<double>(wire_bytes);
+  state.counters["ratio"] =
+      static_cast<double>(payload.size()) / static_cast<double>(wire_bytes);
+}
+
+BENCHMARK_TEMPLATE(BM_CODEC_COMPRESS, HTTP::ENCODING::GZIP)
+    ->ArgsProduct({{1, 6, 9}, {10, 1000, 50000}});
+BENCHMARK_TEMPLATE(BM_CODEC_COMPRESS, HTTP::ENCODING::BROTLI)
+    ->ArgsProduct({{1, 5, 11}, {10, 1000, 50000}});
+BENCHMARK_TEMPLATE(BM_CODEC_COMPRESS, HTTP::ENCODING::ZSTD)
+    ->ArgsProduct({{1, 3, 19}, {10, 1000, 50000}});
+
+template <HTTP::ENCODING TEncoding>
+void BM_CODEC_DECOMPRESS(benchmark::State &state) {
+  auto const payload = make_payload(state.range(1));
+  auto const packed = HTTP::CODEC::compress(TEncoding, payload,
+                                            static_cast<int>(state.range(0)))
+                          .value();
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(HTTP::CODEC::decompress(TEncoding, packed));
+  }
+
+  state.SetBytesProcessed(state.iterations() * payload.size());
+  state.counters["wire_bytes"] = static_cast<double>(packed.size());
+}
+
+BENCHMARK_TEMPLATE(BM_CODEC_DECOMPRESS, HTTP::ENCODING::GZIP)
+    ->ArgsProduct({{6}, {10, 1000, 50000}});
+BENCHMARK_TEMPLATE(BM_CODEC_DECOMPRESS, HTTP::ENCODING::BROTLI)
+    ->ArgsProduct({{5}, {10, 1000, 50000}});
+BENCHMARK_TEMPLATE(BM_CODEC_DECOMPRESS, HTTP::ENCODING::ZSTD)
+    ->ArgsProduct({{3}, {10, 1000, 50000}});
+
+// small, repetitive messages: plain zstd vs zstd with a trained dictionary
+static std::vector<std::string> make_messages(size_t count) {
+  std::vector<std::string> messages;
+  messages.reserve(count);
+  for (size_t idx = 0; idx < count; ++idx) {
+    messages.emplace_back(make_payload(static_cast<int64_t>(idx % 12 + 4)));
+  }
+  return messages;
+}
+
+template <HTTP::ENCODING TEncoding>
+void BM_CODEC_SMALL_MESSAGES(benchmark::State &state) {
+  static auto const messages = make_messages(4000);
+  static auto const dictionary = [] {
+    auto const samples =
+        std::vector<std::string_view>{messages.begin(), messages.end() - 100};
+    return HTTP::CODEC::ZstdDictionary::train(samples).value();
+  }();
+
+  // measure on messages the dictionary was not trained on
+  auto const held_out = std::span{messages}.last(100);
+
+  size_t raw_bytes = 0;
+  size_t wire_bytes = 0;
+
+  for (auto _ : state) {
+    raw_bytes = 0;
+    wire_bytes = 0;
+    for (auto const &message : held_out) {
+      auto packed = HTTP::CODEC::compress(
+          TEncoding, message, HTTP::CompressionConfig::kDefaultLevel,
+          &dictionary);
+      raw_bytes += message.size();
+      wire_bytes += packed.value().size();
+      benchmark::DoNotOptimize(packed);
+    }
+  }
+
+  state.SetItemsProcessed(state.iterations() * held_out.size());
+  state.counters["avg_raw_bytes"] =
+      static_cast<double>(raw_bytes) / static_cast<double>(held_out.size());
+  state.counters["avg_wire_bytes"] =
+      static_cast<double>(wire_bytes) / static_cast<double>(held_out.size());
+}
+
+BENCHMARK_TEMPLATE(BM_CODEC_SMALL_MESSAGES, HTTP::ENCODING::ZSTD);
+BENCHMARK_TEMPLATE(BM_CODEC_SMALL_MESSAGES, HTTP::ENCODING::ZSTD_DICT);
+
+int main(int argc, char **argv) {
+  ::benchmark::Initialize(&argc, argv);
+  if (::benchmark::ReportUnrecognizedArguments(argc, argv)) {
+    return 1;
+  }
+  ::benchmark::RunSpecifiedBenchmarks();
+}
@@ -1,5 +1,12 @@
 #include <benchmark/benchmark.h>
 
+#include <falutez/falutez-serio-arena.hpp>
+#include <falutez/falutez-serio-columns.hpp>
+#include <falutez/falutez-serio-lazy.hpp>
+#include <falutez/falutez-serio-parallel.hpp>
+#include <falutez/falutez-serio-path.hpp>
+#include <falutez/falutez-serio-simd.hpp>
+#include <falutez/falutez-serio-stream.hpp>
 #include <falutez/falutez-serio.hpp>
 
 // templated benchmark over the type of XSON implementation
@@ -14,6 +21,9 @@ template <typename TXSONImpl> void BM_XSON_SERIALIZE(benchmark::State &state) {
 
 BENCHMARK_TEMPLATE(BM_XSON_SERIALIZE, XSON::NLH);
 BENCHMARK_TEMPLATE(BM_XSON_SERIALIZE, XSON::GLZ);
+BENCHMARK_TEMPLATE(BM_XSON_SERIALIZE, XSON::LAZY);
+BENCHMARK_TEMPLATE(BM_XSON_SERIALIZE, XSON::ARENA);
+BENCHMARK_TEMPLATE(BM_XSON_SERIALIZE, XSON::SIMD);
 
 template <typename TXSONImpl>
 void BM_XSON_DESERIALIZE(benchmark::State &state) {
@@ -27,6 +37,9 @@ void BM_XSON_DESERIALIZE(benchmark::State &state) {
 
 BENCHMARK_TEMPLATE(BM_XSON_DESERIALIZE, XSON::NLH);
 BENCHMARK_TEMPLATE(BM_XSON_DESERIALIZE, XSON::GLZ);
+BENCHMARK_TEMPLATE(BM_XSON_DESERIALIZE, XSON::LAZY);
+BENCHMARK_TEMPLATE(BM_XSON_DESERIALIZE, XSON::ARENA);
+BENCHMARK_TEMPLATE(BM_XSON_DESERIALIZE, XSON::SIMD);
 
 template <typename TXSONImpl> void BM_XSON_LOOKUP(benchmark::State &state) {
   TXSONImpl obj;
@@ -50,6 +63,35 @@ template <typename TXSONImpl> void BM_XSON_LOOKUP(benchmark::State &state) {
 
 BENCHMARK_TEMPLATE(BM_XSON_LOOKUP, XSON::NLH);
 BENCHMARK_TEMPLATE(BM_XSON_LOOKUP, XSON::GLZ);
+BENCHMARK_TEMPLATE(BM_XSON_LOOKUP, XSON::LAZY);
+BENCHMARK_TEMPLATE(BM_XSON_LOOKUP, XSON::ARENA);
+BENCHMARK_TEMPLATE(BM_XSON_LOOKUP, XSON::SIMD);
+
+// a wider object, where a lookup has more members to reject
+template <typename TXSONImpl>
+void BM_XSON_LOOKUP_WIDE(benchmark::State &state) {
+  TXSONImpl obj;
+  const auto raw =
+      R"({"id":1,"status":"open","created_at":"2024-01-01","updated_at":)"
+      R"("2024-01-02","owner":"a","owner_id":2,"priority":3,"labels":[],)"
+      R"("title":"t","body":"b","state":"s","state_reason":null,)"
+      R"("comments":4,"locked":false,"milestone":null,"closed_at":null})";
+
+  obj.deserialize(raw);
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(obj.at("closed_at").is_null());
+    benchmark::DoNotOptimize(obj.at("comments").template get<int>());
+    benchmark::DoNotOptimize(obj.has_number_field("owner_id"));
+    benchmark::DoNotOptimize(obj.has_string_field("state_reason"));
+  }
+}
+
+BENCHMARK_TEMPLATE(BM_XSON_LOOKUP_WIDE, XSON::NLH);
+BENCHMARK_TEMPLATE(BM_XSON_LOOKUP_WIDE, XSON::GLZ);
+BENCHMARK_TEMPLATE(BM_XSON_LOOKUP_WIDE, XSON::LAZY);
+BENCHMARK_TEMPLATE(BM_XSON_LOOKUP_WIDE, XSON::ARENA);
+BENCHMARK_TEMPLATE(BM_XSON_LOOKUP_WIDE, XSON::SIMD);
 
 template <typename TXSONImpl> void BM_XSON_MODIFY(benchmark::State &state) {
   TXSONImpl obj;
@@ -66,6 +108,9 @@ template <typename TXSONImpl> void BM_XSON_MODIFY(benchmark::State &state) {
 
 BENCHMARK_TEMPLATE(BM_XSON_MODIFY, XSON::NLH);
 BENCHMARK_TEMPLATE(BM_XSON_MODIFY, XSON::GLZ);
+BENCHMARK_TEMPLATE(BM_XSON_MODIFY, XSON::LAZY);
+BENCHMARK_TEMPLATE(BM_XSON_MODIFY, XSON::ARENA);
+BENCHMARK_TEMPLATE(BM_XSON_MODIFY, XSON::SIMD);
 
 template <typename TXSONImpl> void BM_XSON_HAS_FIELD(benchmark::State &state) {
   TXSONImpl obj;
@@ -84,6 +129,453 @@ template <typename TXSONImpl> void BM_XSON_HAS_FIELD(benchmark::State &state) {
 
 BENCHMARK_TEMPLATE(BM_XSON_HAS_FIELD, XSON::NLH);
 BENCHMARK_TEMPLATE(BM_XSON_HAS_FIELD, XSON::GLZ);
+BENCHMARK_TEMPLATE(BM_XSON_HAS_FIELD, XSON::LAZY);
+BENCHMARK_TEMPLATE(BM_XSON_HAS_FIELD, XSON::ARENA);
+BENCHMARK_TEMPLATE(BM_XSON_HAS_FIELD, XSON::SIMD);
+
+// typed decoding vs the DOM path: an API response of N records decoded into
+// user structs, either directly or via XSON::JSON + field-by-field copies
+namespace {
+struct BenchCustomer {
+  std::string name;
+  std::string tier;
+};
+
+struct BenchOrder {
+  int64_t id = 0;
+  std::string status;
+  double total = 0;
+  BenchCustomer customer;
+  std::vector<std::string> tags;
+};
+
+struct BenchOrders {
+  std::vector<BenchOrder> orders;
+};
+
+std::string make_order(int64_t idx) {
+  return std::format(R"({{"id":{},"status":"{}","total":{:.2f},)"
+                     R"("customer":{{"name":"customer-{}","tier":"gold"}},)"
+                     R"("tags":["a","b","c"]}})",
+                     idx, idx % 2 ? "shipped" : "pending", idx * 3.25, idx);
+}
+
+std::string make_orders(int64_t count) {
+  std::string raw = R"({"orders":[)";
+  for (int64_t idx = 0; idx < count; ++idx) {
+    if (idx != 0)
+      raw += ',';
+    raw += make_order(idx);
+  }
+  raw += "]}";
+  return raw;
+}
+} // namespace
+
+// a large response of which only a few fields are read: the DOM backends
+// build every node, LAZY only the path to the fields touched
+template <typename TXSONImpl>
+void BM_XSON_SPARSE_READ(benchmark::State &state) {
+  auto const raw = make_orders(state.range(0));
+
+  for (auto _ : state) {
+    auto const json = TXSONImpl::parse(raw);
+    auto const &first = json.at("orders").at(0);
+    benchmark::DoNotOptimize(first.at("id").template get<int64_t>());
+    benchmark::DoNotOptimize(first.at("status").template get<std::string>());
+    benchmark::DoNotOptimize(first.at("total").template get<double>());
+  }
+
+  state.SetBytesProcessed(state.iterations() * raw.size());
+}
+
+BENCHMARK_TEMPLATE(BM_XSON_SPARSE_READ, XSON::NLH)->Arg(100)->Arg(10000);
+BENCHMARK_TEMPLATE(BM_XSON_SPARSE_READ, XSON::GLZ)->Arg(100)->Arg(10000);
+BENCHMARK_TEMPLATE(BM_XSON_SPARSE_READ, XSON::LAZY)->Arg(100)->Arg(10000);
+BENCHMARK_TEMPLATE(BM_XSON_SPARSE_READ, XSON::ARENA)->Arg(100)->Arg(10000);
+BENCHMARK_TEMPLATE(BM_XSON_SPARSE_READ, XSON::SIMD)->Arg(100)->Arg(10000);
+
+// a full parse and teardown: one malloc/free per node for NLH and GLZ, a
+// few arena blocks for ARENA
+template <typename TXSONImpl>
+void BM_XSON_PARSE_DESTROY(benchmark::State &state) {
+  auto const raw = make_orders(state.range(0));
+
+  for (auto _ : state) {
+    auto json = TXSONImpl::parse(raw);
+    benchmark::DoNotOptimize(json);
+  }
+
+  state.SetBytesProcessed(state.iterations() * raw.size());
+}
+
+BENCHMARK_TEMPLATE(BM_XSON_PARSE_DESTROY, XSON::NLH)->Arg(100)->Arg(10000);
+BENCHMARK_TEMPLATE(BM_XSON_PARSE_DESTROY, XSON::GLZ)->Arg(100)->Arg(10000);
+BENCHMARK_TEMPLATE(BM_XSON_PARSE_DESTROY, XSON::ARENA)->Arg(100)->Arg(10000);
+BENCHMARK_TEMPLATE(BM_XSON_PARSE_DESTROY, XSON::SIMD)->Arg(100)->Arg(10000);
+
+// the orders array fed in 64 KiB chunks, one small value per element: only
+// one element is ever held, however long the array
+template <typename TXSONImpl> void BM_XSON_STREAM(benchmark::State &state) {
+  auto const orders = make_orders(state.range(0));
+  auto const raw = std::string_view{orders}.substr(
+      orders.find('['), orders.rfind(']') - orders.find('[') + 1);
+  constexpr size_t chunk = size_t{64} << 10;
+
+  for (auto _ : state) {
+    XSON::ArrayStream stream;
+    for (size_t pos = 0; pos < raw.size(); pos += chunk) {
+      stream.feed(raw.substr(pos, chunk));
+      while (auto order = stream.next<TXSONImpl>())
+        benchmark::DoNotOptimize(order);
+    }
+    stream.finish();
+  }
+
+  state.SetBytesProcessed(state.iterations() * raw.size());
+}
+
+BENCHMARK_TEMPLATE(BM_XSON_STREAM, XSON::NLH)->Arg(10000);
+BENCHMARK_TEMPLATE(BM_XSON_STREAM, XSON::GLZ)->Arg(10000);
+BENCHMARK_TEMPLATE(BM_XSON_STREAM, XSON::ARENA)->Arg(10000);
+BENCHMARK_TEMPLATE(BM_XSON_STREAM, XSON::SIMD)->Arg(10000);
+
+// 100k orders as one top-level array, parsed on a pool of 1..16 threads:
+// throughput should grow with the thread count
+template <typename TXSONImpl>
+void BM_XSON_PARALLEL_ARRAY(benchmark::State &state) {
+  auto const orders = make_orders(100000);
+  auto const raw = std::string_view{orders}.substr(
+      orders.find('['), orders.rfind(']') - orders.find('[') + 1);
+  exec::static_thread_pool pool{static_cast<uint32_t>(state.range(0))};
+
+  for (auto _ : state) {
+    auto parsed = XSON::parse_array<TXSONImpl>(raw, pool);
+    benchmark::DoNotOptimize(parsed);
+  }
+
+  state.SetBytesProcessed(state.iterations() * raw.size());
+}
+
+BENCHMARK_TEMPLATE(BM_XSON_PARALLEL_ARRAY, XSON::NLH)
+    ->RangeMultiplier(2)
+    ->Range(1, 16)
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(BM_XSON_PARALLEL_ARRAY, XSON::ARENA)
+    ->RangeMultiplier(2)
+    ->Range(1, 16)
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(BM_XSON_PARALLEL_ARRAY, XSON::SIMD)
+    ->RangeMultiplier(2)
+    ->Range(1, 16)
+    ->UseRealTime();
+
+// the same orders as NDJSON, decoded straight into structs
+void BM_DECODE_PARALLEL_NDJSON(benchmark::State &state) {
+  std::string raw;
+  for (int64_t idx = 0; idx < 100000; ++idx) {
+    raw += make_order(idx);
+    raw += '\n';
+  }
+  exec::static_thread_pool pool{static_cast<uint32_t>(state.range(0))};
+
+  for (auto _ : state) {
+    auto parsed = XSON::parse_ndjson<BenchOrder>(raw, pool);
+    benchmark::DoNotOptimize(parsed);
+  }
+
+  state.SetBytesProcessed(state.iterations() * raw.size());
+}
+
+BENCHMARK(BM_DECODE_PARALLEL_NDJSON)
+    ->RangeMultiplier(2)
+    ->Range(1, 16)
+    ->UseRealTime();
+
+// member names interned once in a registry instead of copied per object
+void BM_ARENA_PARSE_SHAPED(benchmark::State &state) {
+  auto const raw = make_orders(state.range(0));
+  auto const shapes = std::make_shared<XSON::ARENA::Shapes>();
+
+  for (auto _ : state) {
+    auto json = XSON::ARENA::parse(raw, shapes);
+    benchmark::DoNotOptimize(json);
+  }
+
+  state.SetBytesProcessed(state.iterations() * raw.size());
+}
+
+BENCHMARK(BM_ARENA_PARSE_SHAPED)->Arg(100)->Arg(10000);
+
+// one field of every order, by name or through a slot handle
+void BM_ARENA_FIELD(benchmark::State &state) {
+  auto const json = XSON::ARENA::parse(
+      make_orders(10000), std::make_shared<XSON::ARENA::Shapes>());
+  auto const total = XSON::ARENA::Field{"total"};
+  auto const by_slot = state.range(0) != 0;
+
+  for (auto _ : state) {
+    double sum = 0;
+    for (auto const &order : json.at("orders").get_array()) {
+      sum += by_slot ? order.at(total).get<double>()
+                     : order.at("total").get<double>();
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+}
+
+BENCHMARK(BM_ARENA_FIELD)->ArgName("slot")->Arg(0)->Arg(1);
+
+// a deep field through a chain of at() calls or a compiled path
+template <typename TXSONImpl> void BM_XSON_PATH(benchmark::State &state) {
+  auto const json = TXSONImpl::parse(make_orders(100));
+  auto const path = XSON::Path{"/orders/42/customer/name"};
+  auto const compiled = state.range(0) != 0;
+
+  for (auto _ : state) {
+    if (compiled) {
+      benchmark::DoNotOptimize(path.find(json));
+    } else {
+      benchmark::DoNotOptimize(
+          &json.at("orders").at(42).at("customer").at("name"));
+    }
+  }
+}
+
+BENCHMARK_TEMPLATE(BM_XSON_PATH, XSON::NLH)->ArgName("path")->Arg(0)->Arg(1);
+BENCHMARK_TEMPLATE(BM_XSON_PATH, XSON::GLZ)->ArgName("path")->Arg(0)->Arg(1);
+BENCHMARK_TEMPLATE(BM_XSON_PATH, XSON::LAZY)->ArgName("path")->Arg(0)->Arg(1);
+BENCHMARK_TEMPLATE(BM_XSON_PATH, XSON::ARENA)->ArgName("path")->Arg(0)->Arg(1);
+BENCHMARK_TEMPLATE(BM_XSON_PATH, XSON::SIMD)->ArgName("path")->Arg(0)->Arg(1);
+
+// one or three fields straight from the raw text, against parsing it with
+// SIMD and looking them up
+void BM_PATH_EXTRACT(benchmark::State &state) {
+  auto const raw = make_orders(10000);
+  std::vector<XSON::Path> const paths = {XSON::Path{"/orders/5000/total"},
+                                         XSON::Path{"/orders/5000/status"},
+                                         XSON::Path{"/orders/9000/id"}};
+  auto const selected =
+      std::span{paths}.first(static_cast<size_t>(state.range(0)));
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(XSON::Path::extract(selected, raw));
+  }
+
+  state.SetBytesProcessed(state.iterations() * raw.size());
+}
+
+BENCHMARK(BM_PATH_EXTRACT)->ArgName("paths")->Arg(1)->Arg(3);
+
+void BM_PATH_PARSE_FIND(benchmark::State &state) {
+  auto const raw = make_orders(10000);
+  std::vector<XSON::Path> const paths = {XSON::Path{"/orders/5000/total"},
+                                         XSON::Path{"/orders/5000/status"},
+                                         XSON::Path{"/orders/9000/id"}};
+  auto const selected =
+      std::span{paths}.first(static_cast<size_t>(state.range(0)));
+
+  for (auto _ : state) {
+    auto const json = XSON::SIMD::parse(raw);
+    for (auto const &path : selected)
+      benchmark::DoNotOptimize(path.find(json)->serialize());
+  }
+
+  state.SetBytesProcessed(state.iterations() * raw.size());
+}
+
+BENCHMARK(BM_PATH_PARSE_FIND)->ArgName("paths")->Arg(1)->Arg(3);
+
+// two numeric fields of 100k orders into vectors: parse, then at() + get<>
+// per element
+template <typename TXSONImpl>
+void BM_XSON_COLUMN_DOM(benchmark::State &state) {
+  auto const raw = make_orders(100000);
+
+  for (auto _ : state) {
+    auto const json = TXSONImpl::parse(raw);
+    std::vector<double> total;
+    std::vector<int64_t> id;
+    for (auto const &order : json.at("orders").get_array()) {
+      total.push_back(order.at("total").template get<double>());
+      id.push_back(order.at("id").template get<int64_t>());
+    }
+    benchmark::DoNotOptimize(total.data());
+    benchmark::DoNotOptimize(id.data());
+  }
+
+  state.SetBytesProcessed(state.iterations() * raw.size());
+}
+
+BENCHMARK_TEMPLATE(BM_XSON_COLUMN_DOM, XSON::NLH);
+BENCHMARK_TEMPLATE(BM_XSON_COLUMN_DOM, XSON::GLZ);
+BENCHMARK_TEMPLATE(BM_XSON_COLUMN_DOM, XSON::ARENA);
+BENCHMARK_TEMPLATE(BM_XSON_COLUMN_DOM, XSON::SIMD);
+
+// the same two fields as columns, straight from the text
+void BM_COLUMNS(benchmark::State &state) {
+  auto const raw = make_orders(100000);
+  auto const orders = XSON::Path{"/orders"};
+
+  for (auto _ : state) {
+    auto const [total, id] =
+        XSON::columns<double, int64_t>(raw, orders, {"total", "id"});
+    benchmark::DoNotOptimize(total.values.data());
+    benchmark::DoNotOptimize(id.values.data());
+  }
+
+  state.SetBytesProcessed(state.iterations() * raw.size());
+}
+
+BENCHMARK(BM_COLUMNS);
+
+// the error path: a batch of upstream payloads cut off mid-way, rejected by
+// parse() + catch (mode 0) or by try_parse() (mode 1)
+template <typename TXSONImpl>
+void BM_XSON_MALFORMED(benchmark::State &state) {
+  std::vector<std::string> payloads;
+  for (int64_t idx = 0; idx < 1000; ++idx) {
+    auto order = make_order(idx);
+    order.resize(order.size() / 2);
+    payloads.push_back(std::move(order));
+  }
+
+  for (auto _ : state) {
+    size_t rejected = 0;
+    for (auto const &payload : payloads) {
+      if (state.range(0) == 0) {
+        try {
+          benchmark::DoNotOptimize(TXSONImpl::parse(payload));
+        } catch (std::exception const &) {
+          ++rejected;
+        }
+      } else {
+        rejected += TXSONImpl::try_parse(payload).has_value() ? 0 : 1;
+      }
+    }
+    benchmark::DoNotOptimize(rejected);
+  }
+
+  state.SetItemsProcessed(state.iterations() * payloads.size());
+}
+
+BENCHMARK_TEMPLATE(BM_XSON_MALFORMED, XSON::NLH)
+    ->ArgName("try")
+    ->Arg(0)
+    ->Arg(1);
+BENCHMARK_TEMPLATE(BM_XSON_MALFORMED, XSON::GLZ)
+    ->ArgName("try")
+    ->Arg(0)
+    ->Arg(1);
+BENCHMARK_TEMPLATE(BM_XSON_MALFORMED, XSON::LAZY)
+    ->ArgName("try")
+    ->Arg(0)
+    ->Arg(1);
+BENCHMARK_TEMPLATE(BM_XSON_MALFORMED, XSON::ARENA)
+    ->ArgName("try")
+    ->Arg(0)
+    ->Arg(1);
+BENCHMARK_TEMPLATE(BM_XSON_MALFORMED, XSON::SIMD)
+    ->ArgName("try")
+    ->Arg(0)
+    ->Arg(1);
+
+// optional fields that are mostly absent: at() + catch (mode 0) against
+// find() (mode 1), then the value read with try_get<>()
+template <typename TXSONImpl>
+void BM_XSON_MISSING(benchmark::State &state) {
+  auto const json = TXSONImpl::parse(make_order(7));
+  std::array<std::string_view, 4> const keys{"discount", "coupon", "total",
+                                             "note"};
+
+  for (auto _ : state) {
+    double sum = 0;
+    for (auto const key : keys) {
+      if (state.range(0) == 0) {
+        try {
+          sum += json.at(key).template get<double>();
+        } catch (std::exception const &) {
+        }
+      } else if (auto const *value = json.find(key)) {
+        sum += value->template try_get<double>().value_or(0);
+      }
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+}
+
+BENCHMARK_TEMPLATE(BM_XSON_MISSING, XSON::NLH)
+    ->ArgName("find")
+    ->Arg(0)
+    ->Arg(1);
+BENCHMARK_TEMPLATE(BM_XSON_MISSING, XSON::GLZ)
+    ->ArgName("find")
+    ->Arg(0)
+    ->Arg(1);
+BENCHMARK_TEMPLATE(BM_XSON_MISSING, XSON::LAZY)
+    ->ArgName("find")
+    ->Arg(0)
+    ->Arg(1);
+BENCHMARK_TEMPLATE(BM_XSON_MISSING, XSON::ARENA)
+    ->ArgName("find")
+    ->Arg(0)
+    ->Arg(1);
+BENCHMARK_TEMPLATE(BM_XSON_MISSING, XSON::SIMD)
+    ->ArgName("find")
+    ->Arg(0)
+    ->Arg(1);
+
+// teardown alone
+template <typename TXSONImpl> void BM_XSON_DESTROY(benchmark::State &state) {
+  auto const raw = make_orders(state.range(0));
+
+  for (auto _ : state) {
+    state.PauseTiming();
+    auto json = std::make_unique<TXSONImpl>(TXSONImpl::parse(raw));
+    state.ResumeTiming();
+    json.reset();
+  }
+}
+
+BENCHMARK_TEMPLATE(BM_XSON_DESTROY, XSON::NLH)->Arg(10000);
+BENCHMARK_TEMPLATE(BM_XSON_DESTROY, XSON::GLZ)->Arg(10000);
+BENCHMARK_TEMPLATE(BM_XSON_DESTROY, XSON::ARENA)->Arg(10000);
+BENCHMARK_TEMPLATE(BM_XSON_DESTROY, XSON::SIMD)->Arg(10000);
+
+void BM_DECODE_DOM(benchmark::State &state) {
+  auto const raw = make_orders(state.range(0));
+
+  for (auto _ : state) {
+    auto const json = XSON::JSON::parse(raw);
+    BenchOrders result;
+    for (auto const &elm : json.at("orders").get_array()) {
+      auto &order = result.orders.emplace_back();
+      order.id = elm.at("id").get<int64_t>();
+      order.status = elm.at("status").get<std::string>();
+      order.total = elm.at("total").get<double>();
+      order.customer.name = elm.at("customer").at("name").get<std::string>();
+      order.customer.tier = elm.at("customer").at("tier").get<std::string>();
+      order.tags = elm.at("tags").get<std::vector<std::string>>();
+    }
+    benchmark::DoNotOptimize(result);
+  }
+
+  state.SetBytesProcessed(state.iterations() * raw.size());
+}
+
+BENCHMARK(BM_DECODE_DOM)->Arg(1)->Arg(100)->Arg(10000);
+
+void BM_DECODE_TYPED(benchmark::State &state) {
+  auto const raw = make_orders(state.range(0));
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(XSON::decode<BenchOrders>(raw));
+  }
+
+  state.SetBytesProcessed(state.iterations() * raw.size());
+}
+
+BENCHMARK(BM_DECODE_TYPED)->Arg(1)->Arg(100)->Arg(10000);
 
 int main(int argc, char **argv) {
   ::benchmark::Initialize(&argc, argv);
@@ -0,0 +1,274 @@
+#include <atomic>
+#include <cstdlib>
+#include <format>
+#include <map>
+#include <new>
+
+#include <benchmark/benchmark.h>
+
+#include <falutez/falutez-types.hpp>
+
+// every heap allocation in the process; read around the timed loop to report
+// allocations per request
+namespace {
+std::atomic<std::size_t> g_allocs{0};
+} // namespace
+
+void *operator new(std::size_t size) {
+  g_allocs.fetch_add(1, std::memory_order_relaxed);
+  if (auto *ptr = std::malloc(size == 0 ? 1 : size); ptr != nullptr)
+    return ptr;
+  throw std::bad_alloc{};
+}
+
+void operator delete(void *ptr) noexcept { std::free(ptr); }
+
+void operator delete(void *ptr, std::size_t) noexcept { std::free(ptr); }
+
+static constexpr size_t kChunk = 16 * 1024; // curl's default write size
+static constexpr std::string_view kPath = "/api/v1/orders";
+static constexpr std::string_view kQuery = "?page=3&per_page=100";
+
+// the receive side of one request, as the transport did it before pooling:
+// a fresh URL string and a fresh body string grown chunk by chunk
+static void BM_RECEIVE_FRESH(benchmark::State &state) {
+  auto const chunk = std::string(kChunk, 'x');
+  auto const body_size = static_cast<size_t>(state.range(0));
+
+  auto const allocs_before = g_allocs.load();
+
+  for (auto _ : state) {
+    std::string full_path;
+    full_path += kPath;
+    full_path += kQuery;
+    benchmark::DoNotOptimize(full_path);
+
+    std::string received;
+    for (size_t done = 0; done < body_size; done += kChunk)
+      received.append(chunk, 0, std::min(kChunk, body_size - done));
+
+    auto response = HTTP::ResponseDetails{.method = HTTP::METHOD::GET,
+                                          .path = std::string{kPath}};
+    response.body = HTTP::Body{std::move(received)};
+    benchmark::DoNotOptimize(response.body->data());
+  }
+
+  state.counters["allocs_per_request"] =
+      static_cast<double>(g_allocs.load() - allocs_before) /
+      static_cast<double>(state.iterations());
+  state.SetBytesProcessed(state.iterations() * body_size);
+}
+
+BENCHMARK(BM_RECEIVE_FRESH)->Arg(512)->Arg(64 * 1024)->Arg(4 * 1024 * 1024);
+
+// same, with the per-worker URL buffer and the pooled receive buffer that
+// returns to the pool when the response is destroyed
+static void BM_RECEIVE_POOLED(benchmark::State &state) {
+  auto const chunk = std::string(kChunk, 'x');
+  auto const body_size = static_cast<size_t>(state.range(0));
+  auto const &pool = HTTP::internal::BufferPool::local();
+
+  static thread_local std::string full_path;
+
+  auto const allocs_before = g_allocs.load();
+
+  for (auto _ : state) {
+    full_path.clear();
+    full_path += kPath;
+    full_path += kQuery;
+    benchmark::DoNotOptimize(full_path);
+
+    auto received = pool->acquire();
+    for (size_t done = 0; done < body_size; done += kChunk)
+      received->append(chunk, 0, std::min(kChunk, body_size - done));
+
+    auto response = HTTP::ResponseDetails{.method = HTTP::METHOD::GET,
+                                          .path = std::string{kPath}};
+    response.body = HTTP::Body{pool->share(std::move(received))};
+    benchmark::DoNotOptimize(response.body->data());
+  }
+
+  state.counters["allocs_per_request"] =
+      static_cast<double>(g_allocs.load() - allocs_before) /
+      static_cast<double>(state.iterations());
+  state.counters["pool_hits"] = static_cast<double>(pool->stats().hits);
+  state.SetBytesProcessed(state.iterations() * body_size);
+}
+
+BENCHMARK(BM_RECEIVE_POOLED)->Arg(512)->Arg(64 * 1024)->Arg(4 * 1024 * 1024);
+
+// a typical response header block
+static std::map<std::string, std::string> const kResponseFields = {
+    {"Cache-Control", "private, max-age=0"},
+    {"Connection", "keep-alive"},
+    {"Content-Encoding", "gzip"},
+    {"Content-Length", "48213"},
+    {"Content-Type", "application/json; charset=utf-8"},
+    {"Date", "Sat, 17 Oct 2026 09:12:44 GMT"},
+    {"ETag", R"(W/"bc35-18b4a2f")"},
+    {"Server", "nginx"},
+    {"Strict-Transport-Security", "max-age=31536000"},
+    {"Vary", "Accept-Encoding"},
+    {"X-Request-Id", "6c1e1a8e-36b2-4c55-9fd2-0d6c1e8b4a77"},
+    {"X-RateLimit-Remaining", "4999"},
+};
+
+// the previous container: std::unordered_map<std::string, std::string>
+static void BM_HEADERS_BUILD_MAP(benchmark::State &state) {
+  auto const allocs_before = g_allocs.load();
+  for (auto _ : state) {
+    auto headers = std::unordered_map<std::string, std::string>{
+        kResponseFields.begin(), kResponseFields.end()};
+    benchmark::DoNotOptimize(headers);
+  }
+  state.counters["allocs_per_block"] =
+      static_cast<double>(g_allocs.load() - allocs_before) /
+      static_cast<double>(state.iterations());
+}
+
+BENCHMARK(BM_HEADERS_BUILD_MAP);
+
+static void BM_HEADERS_BUILD_FLAT(benchmark::State &state) {
+  auto const allocs_before = g_allocs.load();
+  for (auto _ : state) {
+    auto headers = HTTP::Headers{kResponseFields};
+    benchmark::DoNotOptimize(headers);
+  }
+  state.counters["allocs_per_block"] =
+      static_cast<double>(g_allocs.load() - allocs_before) /
+      static_cast<double>(state.iterations());
+}
+
+BENCHMARK(BM_HEADERS_BUILD_FLAT);
+
+// the lookups the transport does per response; the map can only match the
+// exact spelling, so the lower-case probe goes through a case-folding scan
+// as the old transport-side fallback did
+static void BM_HEADERS_LOOKUP_MAP(benchmark::State &state) {
+  auto const headers = std::unordered_map<std::string, std::string>{
+      kResponseFields.begin(), kResponseFields.end()};
+
+  auto const find_folded = [&](std::string_view name) -> std::string const * {
+    if (auto it = headers.find(std::string{name}); it != headers.end())
+      return &it->second;
+    for (auto const &[key, value] : headers) {
+      if (HTTP::internal::iequals(key, name))
+        return &value;
+    }
+    return nullptr;
+  };
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(find_folded("Content-Type"));
+    benchmark::DoNotOptimize(find_folded("Content-Encoding"));
+    benchmark::DoNotOptimize(find_folded("x-request-id"));
+  }
+}
+
+BENCHMARK(BM_HEADERS_LOOKUP_MAP);
+
+static void BM_HEADERS_LOOKUP_FLAT(benchmark::State &state) {
+  auto const headers = HTTP::Headers{kResponseFields};
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(headers.find(HTTP::FIELD::CONTENT_TYPE));
+    benchmark::DoNotOptimize(headers.find("Content-Encoding"));
+    benchmark::DoNotOptimize(headers.find("x-request-id"));
+  }
+}
+
+BENCHMARK(BM_HEADERS_LOOKUP_FLAT);
+
+// a search-style query: free text, a filter expression, paging and flags
+static HTTP::Parameters make_query() {
+  auto params = HTTP::Parameters{};
+  params.merge(HTTP::Parameters::value_type{
+      {"q", std::pmr::string{"red running shoes & socks"}},
+      {"filter", std::pmr::string{"brand in ('acme','zenith') and size 42"}},
+      {"page", FLZ::int128_t{3}},
+      {"per_page", FLZ::int128_t{100}},
+      {"min_price", 19.99},
+      {"in_stock", true},
+      {"session", std::pmr::string{"6c1e1a8e-36b2-4c55-9fd2-0d6c1e8b4a77"}},
+      {"lang", std::pmr::string{"en-GB"}},
+  });
+  return params;
+}
+
+// the previous builder: per-field += with std::format for numbers and no
+// encoding (so its output is not even a valid URL for this query)
+static void BM_QUERY_CONCAT(benchmark::State &state) {
+  auto const fields = make_query().data();
+  auto const allocs_before = g_allocs.load();
+
+  for (auto _ : state) {
+    std::string url_component;
+    for (const auto &[key, value] : fields) {
+      url_component += url_component.empty() ? "?" : "&";
+      url_component += std::string{key};
+      url_component += "=";
+      if (auto const *integer = std::get_if<FLZ::int128_t>(&value))
+        url_component += std::format("{}", *integer);
+      else if (auto const *real = std::get_if<double>(&value))
+        url_component += std::format("{}", *real);
+      else if (auto const *text = std::get_if<std::pmr::string>(&value))
+        url_component += *text;
+      else
+        url_component += std::get<bool>(value) ? "true" : "false";
+    }
+    benchmark::DoNotOptimize(url_component);
+  }
+
+  state.counters["allocs_per_query"] =
+      static_cast<double>(g_allocs.load() - allocs_before) /
+      static_cast<double>(state.iterations());
+}
+
+BENCHMARK(BM_QUERY_CONCAT);
+
+// percent-encoded, sized once, appended to a reused URL buffer as the
+// transport does
+static void BM_QUERY_ENCODED(benchmark::State &state) {
+  auto const params = make_query();
+  std::string full_path;
+  auto const allocs_before = g_allocs.load();
+
+  for (auto _ : state) {
+    full_path.assign(kPath);
+    params.append_url_component(full_path);
+    benchmark::DoNotOptimize(full_path);
+  }
+
+  state.counters["allocs_per_query"] =
+      static_cast<double>(g_allocs.load() - allocs_before) /
+      static_cast<double>(state.iterations());
+  state.SetBytesProcessed(state.iterations() * full_path.size());
+}
+
+BENCHMARK(BM_QUERY_ENCODED);
+
+// the encoder alone on text that is mostly unreserved vs mostly not
+static void BM_PERCENT_ENCODE(benchmark::State &state) {
+  auto const text = state.range(0) == 0
+                        ? std::string(4096, 'a')
+                        : std::string(4096, ' ');
+  std::string out;
+
+  for (auto _ : state) {
+    out.clear();
+    HTTP::internal::append_encoded(out, text);
+    benchmark::DoNotOptimize(out.data());
+  }
+
+  state.SetBytesProcessed(state.iterations() * text.size());
+}
+
+BENCHMARK(BM_PERCENT_ENCODE)->Arg(0)->Arg(1);
+
+int main(int argc, char **argv) {
+  ::benchmark::Initialize(&argc, argv);
+  if (::benchmark::ReportUnrecognizedArguments(argc, argv)) {
+    return 1;
+  }
+  ::benchmark::RunSpecifiedBenchmarks();
+}
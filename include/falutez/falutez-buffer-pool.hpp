@@ -0,0 +1,223 @@
+#pragma once
+
+/**
+ *  @brief  per-worker recycling of payload buffers. Receive buffers are
+ *          drawn from size-classed free lists and handed back when the last
+ *          Body referring to them goes away, so steady-state traffic stops
+ *          round-tripping through malloc.
+ */
+
+#ifndef _UNIHEADER_BUILD_
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <string>
+#include <vector>
+#endif
+
+namespace HTTP::internal {
+
+/**
+ * @brief size-classed pool of std::string buffers with a cap on the
+ *        capacity it keeps around.
+ *
+ * Class c holds buffers of capacity [2^(c+8), 2^(c+9)). Acquiring rounds
+ * the request up to a class boundary so a buffer always goes back to the
+ * class it came from. Buffers may be released from any thread (a Body can
+ * outlive the worker that filled it), hence the lock; it is uncontended in
+ * the common case of a worker recycling its own buffers.
+ *
+ * share() also recycles the shared_ptr control blocks, so a pooled body
+ * costs no allocation at all once the pool is warm.
+ */
+class BufferPool : public std::enable_shared_from_this<BufferPool> {
+public:
+  static constexpr size_t kMinClassBits = 8;
+  static constexpr size_t kClasses = 17; // 256 B .. 16 MiB
+  static constexpr size_t kDefaultRetainedBytes = 32 * 1024 * 1024;
+
+  struct Stats {
+    size_t hits = 0;
+    size_t misses = 0;
+    size_t dropped = 0;
+    size_t retained_bytes = 0;
+  };
+
+  explicit BufferPool(size_t retained_limit = kDefaultRetainedBytes)
+      : retained_limit_{retained_limit} {}
+
+  BufferPool(BufferPool const &) = delete;
+  BufferPool &operator=(BufferPool const &) = delete;
+
+  ~BufferPool() {
+    for (auto *block : blocks_)
+      ::operator delete(block);
+  }
+
+  /// the calling thread's pool
+  static std::shared_ptr<BufferPool> const &local() {
+    static thread_local auto pool = std::make_shared<BufferPool>();
+    return pool;
+  }
+
+  /// empty buffer with at least @p capacity reserved
+  std::unique_ptr<std::string> acquire(size_t capacity = 0) {
+    auto const wanted = class_for_acquire(capacity);
+
+    if (wanted < kClasses) {
+      auto lock = std::lock_guard{mutex_};
+      for (auto cls = wanted; cls < kClasses; ++cls) {
+        if (auto &list = free_[cls]; !list.empty()) {
+          auto buffer = std::move(list.back());
+          list.pop_back();
+          retained_bytes_ -= buffer->capacity();
+          ++stats_.hits;
+          return buffer;
+        }
+      }
+      ++stats_.misses;
+    }
+
+    auto buffer = std::make_unique<std::string>();
+    buffer->reserve(wanted < kClasses ? size_t{1} << (wanted + kMinClassBits)
+                                      : capacity);
+    return buffer;
+  }
+
+  /// take @p buffer back; kept (cleared) if the retention cap allows
+  void release(std::unique_ptr<std::string> buffer) {
+    if (!buffer)
+      return;
+
+    auto const capacity = buffer->capacity();
+    auto const cls = class_for_release(capacity);
+
+    auto lock = std::lock_guard{mutex_};
+    if (cls >= kClasses || retained_bytes_ + capacity > retained_limit_) {
+      ++stats_.dropped;
+      return;
+    }
+
+    buffer->clear();
+    retained_bytes_ += capacity;
+    free_[cls].push_back(std::move(buffer));
+  }
+
+  /// read-only shared view of @p buffer that comes back here with its
+  /// last reference
+  std::shared_ptr<const std::string>
+  share(std::unique_ptr<std::string> buffer) {
+    auto self = shared_from_this();
+    return std::shared_ptr<const std::string>{
+        buffer.release(), Recycler{self}, BlockAllocator<std::string>{self}};
+  }
+
+  /// bytes of capacity the free lists may hold; excess buffers are freed
+  void set_retained_limit(size_t bytes) {
+    auto lock = std::lock_guard{mutex_};
+    retained_limit_ = bytes;
+    for (auto cls = kClasses; cls-- > 0 && retained_bytes_ > bytes;) {
+      while (!free_[cls].empty() && retained_bytes_ > bytes) {
+        retained_bytes_ -= free_[cls].back()->capacity();
+        free_[cls].pop_back();
+      }
+    }
+  }
+
+  Stats stats() const {
+    auto lock = std::lock_guard{mutex_};
+    auto stats = stats_;
+    stats.retained_bytes = retained_bytes_;
+    return stats;
+  }
+
+private:
+  /// shared_ptr deleter: hand the buffer back instead of deleting it
+  struct Recycler {
+    std::shared_ptr<BufferPool> pool;
+
+    void operator()(std::string const *buffer) const {
+      pool->release(
+          std::unique_ptr<std::string>{const_cast<std::string *>(buffer)});
+    }
+  };
+
+  /// shared_ptr control-block allocator backed by the pool's block list
+  template <typename T> struct BlockAllocator {
+    using value_type = T;
+
+    std::shared_ptr<BufferPool> pool;
+
+    BlockAllocator(std::shared_ptr<BufferPool> owner)
+        : pool{std::move(owner)} {}
+
+    template <typename U>
+    BlockAllocator(BlockAllocator<U> const &other) : pool{other.pool} {}
+
+    T *allocate(size_t count) {
+      return static_cast<T *>(pool->allocate_block(sizeof(T) * count));
+    }
+
+    void deallocate(T *block, size_t count) {
+      pool->deallocate_block(block, sizeof(T) * count);
+    }
+
+    template <typename U>
+    bool operator==(BlockAllocator<U> const &other) const {
+      return pool == other.pool;
+    }
+  };
+
+  static constexpr size_t kBlockSize = 64;
+  static constexpr size_t kMaxBlocks = 1024;
+
+  void *allocate_block(size_t bytes) {
+    if (bytes > kBlockSize)
+      return ::operator new(bytes);
+
+    {
+      auto lock = std::lock_guard{mutex_};
+      if (!blocks_.empty()) {
+        auto *block = blocks_.back();
+        blocks_.pop_back();
+        return block;
+      }
+    }
+    return ::operator new(kBlockSize);
+  }
+
+  void deallocate_block(void *block, size_t bytes) {
+    if (bytes <= kBlockSize) {
+      auto lock = std::lock_guard{mutex_};
+      if (blocks_.size() < kMaxBlocks) {
+        blocks_.push_back(block);
+        return;
+      }
+    }
+    ::operator delete(block);
+  }
+
+  static size_t class_for_acquire(size_t capacity) {
+    auto const bits = std::bit_width(std::max(capacity, size_t{1}) - 1);
+    return bits <= kMinClassBits ? 0 : bits - kMinClassBits;
+  }
+
+  static size_t class_for_release(size_t capacity) {
+    if (capacity < (size_t{1} << kMinClassBits))
+      return kClasses; // small-string sized; not worth keeping
+    return std::bit_width(capacity) - 1 - kMinClassBits;
+  }
+
+  mutable std::mutex mutex_;
+  std::array<std::vector<std::unique_ptr<std::string>>, kClasses> free_;
+  std::vector<void *> blocks_;
+  size_t retained_bytes_ = 0;
+  size_t retained_limit_;
+  Stats stats_;
+};
+
+} // namespace HTTP::internal
@@ -0,0 +1,589 @@
+#pragma once
+
+/**
+ *  @brief  content-coding support (RFC 9110 §8.4): gzip, br and zstd
+ *          compression of bodies, Accept-Encoding negotiation and decoding of
+ *          `Content-Encoding`-tagged responses. Transport independent; the
+ *          implementations call into these around their wire I/O.
+ */
+
+#ifndef _UNIHEADER_BUILD_
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <format>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <brotli/decode.h>
+#include <brotli/encode.h>
+#include <zdict.h>
+#include <zlib.h>
+#include <zstd.h>
+#endif
+
+#include <falutez/falutez-http-status.hpp>
+#include <falutez/falutez-types-std.hpp>
+
+namespace HTTP {
+
+enum class ENCODING {
+  IDENTITY,
+  GZIP,
+  BROTLI,
+  ZSTD,
+  /// zstd with a pre-shared trained dictionary (see CODEC::ZstdDictionary)
+  ZSTD_DICT,
+};
+
+namespace CODEC {
+class ZstdDictionary;
+} // namespace CODEC
+
+/**
+ * @brief per-client compression settings
+ *  - accept_compressed: advertise `Accept-Encoding` and transparently decode
+ *    compressed responses into the Body
+ *  - request_encoding: opt-in coding for outgoing bodies of at least
+ *    `min_request_size` bytes (sent with `Content-Encoding`)
+ *  - level: codec-specific level; `kDefaultLevel` picks the codec default
+ *  - dictionary: zstd dictionary shared with a cooperating server; enables
+ *    the `zstd-dict` coding in both directions
+ *  - max_decoded_size: decoding a response body stops with EMSGSIZE once it
+ *    would grow past this many bytes (a few KB of gzip or zstd can expand
+ *    to gigabytes)
+ */
+struct CompressionConfig {
+  static constexpr int kDefaultLevel = -1;
+  static constexpr size_t kDefaultMaxDecodedSize = size_t{256} * 1024 * 1024;
+
+  bool accept_compressed = true;
+  ENCODING request_encoding = ENCODING::IDENTITY;
+  int level = kDefaultLevel;
+  size_t min_request_size = 1024;
+  std::shared_ptr<const CODEC::ZstdDictionary> dictionary;
+  size_t max_decoded_size = kDefaultMaxDecodedSize;
+};
+
+namespace CODEC {
+
+using result_type = FLZ::expected<std::string, HTTP::STATUS>;
+
+inline HTTP::STATUS codec_error(std::string_view what) {
+  return HTTP::STATUS{std::pair<int16_t, std::string_view>{EBADMSG, what}};
+}
+
+inline HTTP::STATUS limit_error(std::string_view what) {
+  return HTTP::STATUS{std::pair<int16_t, std::string_view>{EMSGSIZE, what}};
+}
+
+/// content-coding token as used on the wire
+constexpr std::string_view name(ENCODING encoding) {
+  constexpr auto kNames = std::array<std::string_view, 5>{
+      "identity", "gzip", "br", "zstd", "zstd-dict"};
+  return kNames[static_cast<int>(encoding)];
+}
+
+/// parse a single content-coding token (case-insensitive, surrounding
+/// whitespace ignored)
+constexpr std::optional<ENCODING> from_name(std::string_view token) {
+  while (!token.empty() && (token.front() == ' ' || token.front() == '\t'))
+    token.remove_prefix(1);
+  while (!token.empty() && (token.back() == ' ' || token.back() == '\t'))
+    token.remove_suffix(1);
+
+  auto const iequals = [](std::string_view lhs, std::string_view rhs) {
+    if (lhs.size() != rhs.size())
+      return false;
+    for (size_t idx = 0; idx < lhs.size(); ++idx) {
+      auto lower = lhs[idx];
+      if (lower >= 'A' && lower <= 'Z')
+        lower = static_cast<char>(lower - 'A' + 'a');
+      if (lower != rhs[idx])
+        return false;
+    }
+    return true;
+  };
+
+  if (iequals(token, "gzip") || iequals(token, "x-gzip"))
+    return ENCODING::GZIP;
+  if (iequals(token, "br"))
+    return ENCODING::BROTLI;
+  if (iequals(token, "zstd"))
+    return ENCODING::ZSTD;
+  if (iequals(token, "zstd-dict"))
+    return ENCODING::ZSTD_DICT;
+  if (token.empty() || iequals(token, "identity"))
+    return ENCODING::IDENTITY;
+  return std::nullopt;
+}
+
+/// value for the `Accept-Encoding` request header, best ratio first
+constexpr std::string_view accept_encoding(bool with_dictionary = false) {
+  return with_dictionary ? "zstd-dict, zstd, br, gzip" : "zstd, br, gzip";
+}
+
+/// request header advertising the id of the dictionary the client holds; a
+/// server that has the same one may answer with `Content-Encoding: zstd-dict`
+constexpr std::string_view kDictionaryHeader = "Zstd-Dictionary-Id";
+
+/**
+ * @brief ZstdDictionary - a zstd dictionary trained from sample payloads
+ * @note  small JSON messages (a few KB, same keys every time) barely compress
+ *        on their own; with a dictionary built from representative samples
+ *        the repeated structure is already "known" to both sides. Digested
+ *        (CDict/DDict) forms are prepared once and shared across threads.
+ */
+class ZstdDictionary {
+public:
+  static constexpr size_t kDefaultCapacity = 16 * 1024;
+
+  /// load a dictionary produced by train() (or the zstd CLI `--train`)
+  explicit ZstdDictionary(std::string bytes,
+                          int level = CompressionConfig::kDefaultLevel)
+      : bytes_{std::move(bytes)},
+        level_{level == CompressionConfig::kDefaultLevel ? ZSTD_CLEVEL_DEFAULT
+                                                         : level},
+        cdict_{ZSTD_createCDict(bytes_.data(), bytes_.size(), level_)},
+        ddict_{ZSTD_createDDict(bytes_.data(), bytes_.size())},
+        id_{ZSTD_getDictID_fromDict(bytes_.data(), bytes_.size())} {
+    if (!cdict_ || !ddict_)
+      throw std::runtime_error{std::format(
+          "{}:{}:{}: invalid zstd dictionary", __FILE__, __LINE__, __func__)};
+  }
+
+  ZstdDictionary(ZstdDictionary &&) = default;
+  ZstdDictionary &operator=(ZstdDictionary &&) = default;
+  ZstdDictionary(ZstdDictionary const &) = delete;
+  ZstdDictionary &operator=(ZstdDictionary const &) = delete;
+
+  /// train a dictionary of at most @p capacity bytes from sample payloads
+  static FLZ::expected<ZstdDictionary, HTTP::STATUS>
+  train(std::span<const std::string_view> samples,
+        size_t capacity = kDefaultCapacity,
+        int level = CompressionConfig::kDefaultLevel) {
+    std::string concatenated;
+    std::vector<size_t> sizes;
+    sizes.reserve(samples.size());
+
+    for (auto const sample : samples) {
+      concatenated += sample;
+      sizes.push_back(sample.size());
+    }
+
+    std::string bytes;
+    bytes.resize(capacity);
+
+    auto const written = ZDICT_trainFromBuffer(
+        bytes.data(), bytes.size(), concatenated.data(), sizes.data(),
+        static_cast<unsigned>(sizes.size()));
+
+    if (ZDICT_isError(written))
+      return FLZ::unexpected(HTTP::STATUS{std::pair<int16_t, std::string_view>{
+          EINVAL, ZDICT_getErrorName(written)}});
+
+    bytes.resize(written);
+    return ZstdDictionary{std::move(bytes), level};
+  }
+
+  [[nodiscard]] uint32_t id() const noexcept { return id_; }
+
+  [[nodiscard]] int level() const noexcept { return level_; }
+
+  /// raw dictionary content, e.g. to persist or hand to the server side
+  [[nodiscard]] std::string const &bytes() const noexcept { return bytes_; }
+
+  [[nodiscard]] ZSTD_CDict const *cdict() const noexcept {
+    return cdict_.get();
+  }
+
+  [[nodiscard]] ZSTD_DDict const *ddict() const noexcept {
+    return ddict_.get();
+  }
+
+private:
+  struct CDictDeleter {
+    void operator()(ZSTD_CDict *dict) const { ZSTD_freeCDict(dict); }
+  };
+  struct DDictDeleter {
+    void operator()(ZSTD_DDict *dict) const { ZSTD_freeDDict(dict); }
+  };
+
+  std::string bytes_;
+  int level_;
+  std::unique_ptr<ZSTD_CDict, CDictDeleter> cdict_;
+  std::unique_ptr<ZSTD_DDict, DDictDeleter> ddict_;
+  uint32_t id_;
+};
+
+namespace internal {
+
+/// most zlib takes or gives in one call: avail_in and avail_out are uInt,
+/// so larger buffers go through in pieces of this size
+inline constexpr size_t kZlibChunk = std::numeric_limits<uInt>::max();
+
+/// point @p stream at the next piece of @p input once it has used up the
+/// last one; @p fed counts the bytes handed over so far
+inline void zlib_feed(z_stream &stream, std::string_view input, size_t &fed) {
+  if (stream.avail_in != 0 || fed == input.size())
+    return;
+  auto const piece = std::min(input.size() - fed, kZlibChunk);
+  stream.next_in =
+      reinterpret_cast<Bytef *>(const_cast<char *>(input.data() + fed));
+  stream.avail_in = static_cast<uInt>(piece);
+  fed += piece;
+}
+
+inline result_type gzip_compress(std::string_view input, int level) {
+  z_stream stream{};
+  if (deflateInit2(&stream,
+                   level == CompressionConfig::kDefaultLevel
+                       ? Z_DEFAULT_COMPRESSION
+                       : level,
+                   Z_DEFLATED, 15 + 16 /* gzip wrapper */, 8,
+                   Z_DEFAULT_STRATEGY) != Z_OK)
+    return FLZ::unexpected(codec_error("gzip: deflateInit2() failed"));
+
+  std::string output;
+  output.resize(deflateBound(&stream, input.size()));
+
+  size_t fed = 0;
+  size_t written = 0;
+  int rc = Z_OK;
+  while (rc == Z_OK) {
+    zlib_feed(stream, input, fed);
+    if (written == output.size())
+      output.resize(output.size() * 2);
+
+    auto const room = std::min(output.size() - written, kZlibChunk);
+    stream.next_out = reinterpret_cast<Bytef *>(output.data() + written);
+    stream.avail_out = static_cast<uInt>(room);
+
+    // Z_FINISH only once the last piece is in, or deflate() would end the
+    // stream over a prefix of the input
+    rc = deflate(&stream, fed == input.size() ? Z_FINISH : Z_NO_FLUSH);
+    written += room - stream.avail_out;
+  }
+  output.resize(written);
+  deflateEnd(&stream);
+
+  if (rc != Z_STREAM_END)
+    return FLZ::unexpected(codec_error("gzip: deflate() did not finish"));
+
+  return output;
+}
+
+inline result_type gzip_decompress(std::string_view input, size_t max_size) {
+  z_stream stream{};
+  // 32: auto-detect gzip or zlib wrapper (servers mislabel "deflate")
+  if (inflateInit2(&stream, 15 + 32) != Z_OK)
+    return FLZ::unexpected(codec_error("gzip: inflateInit2() failed"));
+
+  std::string output;
+  output.resize(std::min(std::max<size_t>(input.size() * 4, 4096), max_size));
+
+  size_t fed = 0;
+  size_t written = 0;
+  int rc = Z_OK;
+  while (rc != Z_STREAM_END) {
+    zlib_feed(stream, input, fed);
+    if (written == output.size() && output.size() < max_size)
+      output.resize(std::min(output.size() * 2, max_size));
+
+    // at the limit inflate() gets one spare byte: it may still have the
+    // trailer to read, but anything it writes there is over the limit
+    Bytef spare = 0;
+    auto const room = std::min(output.size() - written, kZlibChunk);
+    auto const avail = room != 0 ? room : 1;
+    stream.next_out = room != 0
+                          ? reinterpret_cast<Bytef *>(output.data() + written)
+                          : &spare;
+    stream.avail_out = static_cast<uInt>(avail);
+
+    rc = inflate(&stream, Z_NO_FLUSH);
+    auto const produced = avail - stream.avail_out;
+    if (room == 0 && produced != 0) {
+      inflateEnd(&stream);
+      return FLZ::unexpected(limit_error("gzip: decoded size over limit"));
+    }
+    written += produced;
+
+    if (rc == Z_BUF_ERROR && stream.avail_in == 0 && fed == input.size())
+      break; // truncated input
+    if (rc != Z_OK && rc != Z_STREAM_END && rc != Z_BUF_ERROR)
+      break;
+  }
+
+  output.resize(written);
+  inflateEnd(&stream);
+
+  if (rc != Z_STREAM_END)
+    return FLZ::unexpected(codec_error("gzip: corrupt or truncated stream"));
+
+  return output;
+}
+
+inline result_type brotli_compress(std::string_view input, int level) {
+  std::string output;
+  auto out_size = BrotliEncoderMaxCompressedSize(input.size());
+  output.resize(out_size == 0 ? input.size() + 1024 : out_size);
+  out_size = output.size();
+
+  if (BrotliEncoderCompress(level == CompressionConfig::kDefaultLevel
+                                ? BROTLI_DEFAULT_QUALITY
+                                : level,
+                            BROTLI_DEFAULT_WINDOW, BROTLI_MODE_TEXT,
+                            input.size(),
+                            reinterpret_cast<uint8_t const *>(input.data()),
+                            &out_size,
+                            reinterpret_cast<uint8_t *>(output.data())) ==
+      BROTLI_FALSE)
+    return FLZ::unexpected(codec_error("br: BrotliEncoderCompress() failed"));
+
+  output.resize(out_size);
+  return output;
+}
+
+inline result_type brotli_decompress(std::string_view input,
+                                     size_t max_size) {
+  auto *state = BrotliDecoderCreateInstance(nullptr, nullptr, nullptr);
+  if (state == nullptr)
+    return FLZ::unexpected(codec_error("br: decoder allocation failed"));
+
+  std::string output;
+  output.resize(std::min(std::max<size_t>(input.size() * 4, 4096), max_size));
+
+  auto avail_in = input.size();
+  auto const *next_in = reinterpret_cast<uint8_t const *>(input.data());
+  size_t total_out = 0;
+
+  auto rc = BROTLI_DECODER_RESULT_NEEDS_MORE_OUTPUT;
+  while (rc == BROTLI_DECODER_RESULT_NEEDS_MORE_OUTPUT) {
+    if (total_out == output.size()) {
+      if (output.size() >= max_size) {
+        BrotliDecoderDestroyInstance(state);
+        return FLZ::unexpected(limit_error("br: decoded size over limit"));
+      }
+      output.resize(std::min(output.size() * 2, max_size));
+    }
+
+    auto avail_out = output.size() - total_out;
+    auto *next_out = reinterpret_cast<uint8_t *>(output.data() + total_out);
+
+    rc = BrotliDecoderDecompressStream(state, &avail_in, &next_in, &avail_out,
+                                       &next_out, nullptr);
+    total_out = output.size() - avail_out;
+  }
+
+  BrotliDecoderDestroyInstance(state);
+
+  if (rc != BROTLI_DECODER_RESULT_SUCCESS)
+    return FLZ::unexpected(codec_error("br: corrupt or truncated stream"));
+
+  output.resize(total_out);
+  return output;
+}
+
+inline result_type zstd_compress(std::string_view input, int level,
+                                 ZstdDictionary const *dictionary = nullptr) {
+  struct CCtxDeleter {
+    void operator()(ZSTD_CCtx *ctx) const { ZSTD_freeCCtx(ctx); }
+  };
+  static thread_local auto cctx =
+      std::unique_ptr<ZSTD_CCtx, CCtxDeleter>{ZSTD_createCCtx()};
+
+  if (!cctx)
+    return FLZ::unexpected(codec_error("zstd: context allocation failed"));
+
+  std::string output;
+  output.resize(ZSTD_compressBound(input.size()));
+
+  // the digested dictionary carries its own level
+  auto const written =
+      dictionary != nullptr
+          ? ZSTD_compress_usingCDict(cctx.get(), output.data(), output.size(),
+                                     input.data(), input.size(),
+                                     dictionary->cdict())
+          : ZSTD_compressCCtx(cctx.get(), output.data(), output.size(),
+                              input.data(), input.size(),
+                              level == CompressionConfig::kDefaultLevel
+                                  ? ZSTD_CLEVEL_DEFAULT
+                                  : level);
+
+  if (ZSTD_isError(written))
+    return FLZ::unexpected(codec_error(ZSTD_getErrorName(written)));
+
+  output.resize(written);
+  return output;
+}
+
+inline result_type zstd_decompress(std::string_view input, size_t max_size,
+                                   ZstdDictionary const *dictionary = nullptr) {
+  // streaming decode: content size is optional in the frame header and
+  // a body may carry several concatenated frames
+  struct DCtxDeleter {
+    void operator()(ZSTD_DCtx *ctx) const { ZSTD_freeDCtx(ctx); }
+  };
+  static thread_local auto dctx =
+      std::unique_ptr<ZSTD_DCtx, DCtxDeleter>{ZSTD_createDCtx()};
+
+  if (!dctx)
+    return FLZ::unexpected(codec_error("zstd: context allocation failed"));
+
+  ZSTD_DCtx_reset(dctx.get(), ZSTD_reset_session_only);
+
+  if (dictionary != nullptr) {
+    if (auto const frame_dict = ZSTD_getDictID_fromFrame(input.data(),
+                                                         input.size());
+        frame_dict != 0 && frame_dict != dictionary->id())
+      return FLZ::unexpected(
+          codec_error("zstd: frame encoded with a different dictionary"));
+  }
+  // referencing (or un-referencing with nullptr) is sticky across sessions
+  ZSTD_DCtx_refDDict(dctx.get(),
+                     dictionary != nullptr ? dictionary->ddict() : nullptr);
+
+  // the declared content size is only a hint, and an untrusted one: a
+  // frame claiming more than the limit is refused, and the first buffer is
+  // never larger than a plausible ratio of the input
+  auto const content_size =
+      ZSTD_getFrameContentSize(input.data(), input.size());
+  auto const declared = content_size != ZSTD_CONTENTSIZE_UNKNOWN &&
+                        content_size != ZSTD_CONTENTSIZE_ERROR;
+  if (declared && content_size > max_size)
+    return FLZ::unexpected(limit_error("zstd: decoded size over limit"));
+
+  auto const estimate = std::max<size_t>(input.size() * 4,
+                                         ZSTD_DStreamOutSize());
+  std::string output;
+  output.resize(std::min(
+      declared ? std::min(static_cast<size_t>(content_size), estimate * 8)
+               : estimate,
+      max_size));
+
+  auto in_buf = ZSTD_inBuffer{input.data(), input.size(), 0};
+  size_t total_out = 0;
+  size_t rc = 0;
+
+  do {
+    if (total_out == output.size()) {
+      if (output.size() >= max_size)
+        return FLZ::unexpected(limit_error("zstd: decoded size over limit"));
+      output.resize(std::min(
+          std::max(output.size() * 2, ZSTD_DStreamOutSize()), max_size));
+    }
+
+    auto out_buf = ZSTD_outBuffer{output.data() + total_out,
+                                  output.size() - total_out, 0};
+    rc = ZSTD_decompressStream(dctx.get(), &out_buf, &in_buf);
+    total_out += out_buf.pos;
+
+    if (ZSTD_isError(rc))
+      return FLZ::unexpected(codec_error(ZSTD_getErrorName(rc)));
+  } while (in_buf.pos < in_buf.size || (rc != 0 && total_out == output.size()));
+
+  if (rc != 0)
+    return FLZ::unexpected(codec_error("zstd: truncated stream"));
+
+  output.resize(total_out);
+  return output;
+}
+
+} // namespace internal
+
+inline result_type compress(ENCODING encoding, std::string_view input,
+                            int level = CompressionConfig::kDefaultLevel,
+                            ZstdDictionary const *dictionary = nullptr) {
+  switch (encoding) {
+  case ENCODING::IDENTITY:
+    return std::string{input};
+  case ENCODING::GZIP:
+    return internal::gzip_compress(input, level);
+  case ENCODING::BROTLI:
+    return internal::brotli_compress(input, level);
+  case ENCODING::ZSTD:
+    return internal::zstd_compress(input, level);
+  case ENCODING::ZSTD_DICT:
+    if (dictionary == nullptr)
+      return FLZ::unexpected(codec_error("zstd-dict: no dictionary"));
+    return internal::zstd_compress(input, level, dictionary);
+  }
+  return FLZ::unexpected(codec_error("unknown content coding"));
+}
+
+/// @param max_size decoded output larger than this fails with EMSGSIZE
+inline result_type
+decompress(ENCODING encoding, std::string_view input,
+           ZstdDictionary const *dictionary = nullptr,
+           size_t max_size = CompressionConfig::kDefaultMaxDecodedSize) {
+  switch (encoding) {
+  case ENCODING::IDENTITY:
+    return std::string{input};
+  case ENCODING::GZIP:
+    return internal::gzip_decompress(input, max_size);
+  case ENCODING::BROTLI:
+    return internal::brotli_decompress(input, max_size);
+  case ENCODING::ZSTD:
+    return internal::zstd_decompress(input, max_size);
+  case ENCODING::ZSTD_DICT:
+    if (dictionary == nullptr)
+      return FLZ::unexpected(codec_error("zstd-dict: no dictionary"));
+    return internal::zstd_decompress(input, max_size, dictionary);
+  }
+  return FLZ::unexpected(codec_error("unknown content coding"));
+}
+
+/**
+ * @brief undo a `Content-Encoding` header value; codings are listed in the
+ *        order they were applied, so they are removed right to left
+ * @param  max_size bound on every intermediate and the final decoded size
+ * @return std::nullopt when the header names only `identity` or @p input is
+ *         empty (nothing to do)
+ */
+inline FLZ::expected<std::optional<std::string>, HTTP::STATUS>
+decode(std::string_view content_encoding, std::string_view input,
+       ZstdDictionary const *dictionary = nullptr,
+       size_t max_size = CompressionConfig::kDefaultMaxDecodedSize) {
+  std::optional<std::string> decoded;
+
+  // e.g. HEAD, 204 or 304 answers, which carry the coding but no body
+  if (input.empty())
+    return decoded;
+
+  while (!content_encoding.empty()) {
+    auto const comma = content_encoding.rfind(',');
+    auto const token = comma == std::string_view::npos
+                           ? content_encoding
+                           : content_encoding.substr(comma + 1);
+    content_encoding = comma == std::string_view::npos
+                           ? std::string_view{}
+                           : content_encoding.substr(0, comma);
+
+    auto const encoding = from_name(token);
+    if (!encoding.has_value())
+      return FLZ::unexpected(HTTP::STATUS{std::pair<int16_t, std::string_view>{
+          ENOTSUP, "unsupported content coding"}});
+
+    if (encoding.value() == ENCODING::IDENTITY)
+      continue;
+
+    auto step = decompress(encoding.value(),
+                           decoded.has_value() ? *decoded : input, dictionary,
+                           max_size);
+    if (!step.has_value())
+      return FLZ::unexpected(std::move(step.error()));
+    decoded = std::move(step.value());
+  }
+
+  return decoded;
+}
+
+} // namespace CODEC
+
+} // namespace HTTP
@@ -0,0 +1,288 @@
+#pragma once
+
+/**
+ *  @brief  large-object download support: spec/result types, the
+ *          preallocated memory-mapped destination ranges are written into,
+ *          and the sidecar journal that lets a partial download resume.
+ *          Transport independent; implementations drive the ranged GETs.
+ */
+
+#ifndef _UNIHEADER_BUILD_
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <format>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <falutez/falutez-http-status.hpp>
+#include <falutez/falutez-types.hpp>
+
+namespace HTTP {
+
+struct DownloadSpec {
+  std::string path;
+  std::optional<Headers> headers;
+  /// file the object is written to; created or resized as needed
+  std::filesystem::path destination;
+  /// bytes per ranged GET
+  size_t chunk_size = 8 * 1024 * 1024;
+  /// concurrent ranges; 0 uses the implementation's worker count, which
+  /// also bounds it
+  size_t max_parallel = 0;
+  /// attempts per range after the first before the download fails
+  uint32_t max_retries = 3;
+  /// linear backoff between attempts of the same range
+  std::chrono::milliseconds retry_backoff{100};
+  /// pick up ranges recorded as complete by an earlier, interrupted run
+  bool resume = true;
+};
+
+struct DownloadResult {
+  size_t size = 0;
+  /// ranges the object was split into (1 for a plain GET)
+  size_t ranges = 0;
+  /// ranges skipped because a previous run had already written them
+  size_t ranges_resumed = 0;
+  /// failed range attempts that were retried
+  size_t retries = 0;
+  /// false if the server did not advertise byte ranges and a single GET
+  /// was used instead
+  bool ranged = false;
+};
+
+using Download = FLZ::expected<DownloadResult, HTTP::STATUS>;
+
+namespace internal {
+
+inline HTTP::STATUS download_error(int16_t code, std::string_view what) {
+  return HTTP::STATUS{std::pair<int16_t, std::string_view>{code, what}};
+}
+
+/**
+ * @brief destination file preallocated to the object size and mapped
+ *        shared, so each range lands directly at its offset from any worker
+ */
+class MappedFile {
+public:
+  MappedFile() = default;
+
+  MappedFile(MappedFile &&other) noexcept
+      : fd_{std::exchange(other.fd_, -1)},
+        data_{std::exchange(other.data_, nullptr)},
+        size_{std::exchange(other.size_, 0)} {}
+
+  MappedFile &operator=(MappedFile &&other) noexcept {
+    if (this != &other) {
+      reset();
+      fd_ = std::exchange(other.fd_, -1);
+      data_ = std::exchange(other.data_, nullptr);
+      size_ = std::exchange(other.size_, 0);
+    }
+    return *this;
+  }
+
+  MappedFile(MappedFile const &) = delete;
+  MappedFile &operator=(MappedFile const &) = delete;
+
+  ~MappedFile() { reset(); }
+
+  /// open (without truncating, so resumed ranges survive) and size @p path
+  static FLZ::expected<MappedFile, HTTP::STATUS>
+  open(std::filesystem::path const &path, size_t size) {
+    MappedFile file;
+
+    file.fd_ = ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (file.fd_ < 0)
+      return FLZ::unexpected(download_error(
+          static_cast<int16_t>(errno),
+          std::format("{}:{}:{}: open({}): {}", __FILE__, __LINE__, __func__,
+                      path.string(), std::strerror(errno))));
+
+    if (::ftruncate(file.fd_, static_cast<off_t>(size)) != 0)
+      return FLZ::unexpected(download_error(
+          static_cast<int16_t>(errno),
+          std::format("{}:{}:{}: ftruncate({}, {}): {}", __FILE__, __LINE__,
+                      __func__, path.string(), size, std::strerror(errno))));
+
+    file.size_ = size;
+
+    if (size == 0)
+      return file;
+
+    auto *mapped = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED,
+                          file.fd_, 0);
+    if (mapped == MAP_FAILED)
+      return FLZ::unexpected(download_error(
+          static_cast<int16_t>(errno),
+          std::format("{}:{}:{}: mmap({}, {}): {}", __FILE__, __LINE__,
+                      __func__, path.string(), size, std::strerror(errno))));
+
+    file.data_ = static_cast<std::byte *>(mapped);
+    return file;
+  }
+
+  std::span<std::byte> bytes() const { return {data_, size_}; }
+
+  /// write the mapped pages holding [@p offset, @p offset + @p length)
+  /// through to the file and wait for them; false (errno set) on failure
+  bool sync(size_t offset, size_t length) const {
+    if (length == 0)
+      return true;
+    // msync() takes a page-aligned start
+    auto const page = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+    auto const start = offset / page * page;
+    return ::msync(data_ + start, offset + length - start, MS_SYNC) == 0;
+  }
+
+  size_t size() const { return size_; }
+
+private:
+  void reset() {
+    if (data_ != nullptr)
+      ::munmap(data_, size_);
+    if (fd_ >= 0)
+      ::close(fd_);
+    data_ = nullptr;
+    fd_ = -1;
+    size_ = 0;
+  }
+
+  int fd_ = -1;
+  std::byte *data_ = nullptr;
+  size_t size_ = 0;
+};
+
+/**
+ * @brief `<destination>.falutez-part` sidecar recording which ranges of an
+ *        in-flight download are on disk.
+ *
+ * One header line identifying the object (size, chunk size, validator)
+ * followed by one '0'/'1' byte per range. Workers flip their own byte with
+ * pwrite(), so marking is lock-free. A journal whose header does not match
+ * the current object is discarded and the download starts over.
+ *
+ * A range is only marked once its bytes have been synced to the
+ * destination (MappedFile::sync()), so after a crash every '1' stands for
+ * data on disk. The mark itself is not synced: losing it only means the
+ * range is fetched again.
+ */
+class DownloadJournal {
+public:
+  static constexpr std::string_view kSuffix = ".falutez-part";
+
+  DownloadJournal() = default;
+
+  DownloadJournal(DownloadJournal &&other) noexcept
+      : path_{std::move(other.path_)}, fd_{std::exchange(other.fd_, -1)},
+        header_size_{other.header_size_}, done_{std::move(other.done_)} {}
+
+  DownloadJournal &operator=(DownloadJournal &&) = delete;
+  DownloadJournal(DownloadJournal const &) = delete;
+  DownloadJournal &operator=(DownloadJournal const &) = delete;
+
+  ~DownloadJournal() {
+    if (fd_ >= 0)
+      ::close(fd_);
+  }
+
+  static FLZ::expected<DownloadJournal, HTTP::STATUS>
+  open(std::filesystem::path const &destination, size_t size, size_t chunk,
+       std::string_view validator, bool resume) {
+    DownloadJournal journal;
+    journal.path_ = destination;
+    journal.path_ += kSuffix;
+
+    auto const ranges = (size + chunk - 1) / chunk;
+    auto const header =
+        std::format("falutez-part 1 {} {} {}\n", size, chunk, validator);
+
+    journal.header_size_ = header.size();
+    journal.done_.assign(ranges, false);
+
+    journal.fd_ = ::open(journal.path_.c_str(), O_RDWR | O_CREAT | O_CLOEXEC,
+                         0644);
+    if (journal.fd_ < 0)
+      return FLZ::unexpected(download_error(
+          static_cast<int16_t>(errno),
+          std::format("{}:{}:{}: open({}): {}", __FILE__, __LINE__, __func__,
+                      journal.path_.string(), std::strerror(errno))));
+
+    std::string existing(header.size() + ranges, '\0');
+    auto const got = ::pread(journal.fd_, existing.data(), existing.size(), 0);
+
+    if (resume && got == static_cast<ssize_t>(existing.size()) &&
+        existing.starts_with(header)) {
+      for (size_t idx = 0; idx < ranges; ++idx)
+        journal.done_[idx] = existing[header.size() + idx] == '1';
+      return journal;
+    }
+
+    // new or stale: start over
+    auto fresh = header + std::string(ranges, '0');
+    if (::ftruncate(journal.fd_, 0) != 0 ||
+        ::pwrite(journal.fd_, fresh.data(), fresh.size(), 0) !=
+            static_cast<ssize_t>(fresh.size()))
+      return FLZ::unexpected(download_error(
+          static_cast<int16_t>(errno),
+          std::format("{}:{}:{}: write({}): {}", __FILE__, __LINE__, __func__,
+                      journal.path_.string(), std::strerror(errno))));
+
+    return journal;
+  }
+
+  size_t ranges() const { return done_.size(); }
+
+  /// state as loaded at open(); not updated by mark_done()
+  bool done(size_t range) const { return done_[range]; }
+
+  size_t resumed() const { return std::ranges::count(done_, true); }
+
+  /// the range's data must already be on disk; safe to call concurrently
+  /// for distinct ranges
+  bool mark_done(size_t range) const {
+    static constexpr char kDone = '1';
+    return ::pwrite(fd_, &kDone, 1,
+                    static_cast<off_t>(header_size_ + range)) == 1;
+  }
+
+  /// download complete; the journal is no longer needed
+  void remove() {
+    if (fd_ >= 0)
+      ::close(fd_);
+    fd_ = -1;
+    std::error_code ignored;
+    std::filesystem::remove(path_, ignored);
+  }
+
+  /// drop any journal left next to @p destination by an earlier ranged
+  /// run, for a download that rewrites the destination whole
+  static void discard(std::filesystem::path const &destination) {
+    auto path = destination;
+    path += kSuffix;
+    std::error_code ignored;
+    std::filesystem::remove(path, ignored);
+  }
+
+private:
+  std::filesystem::path path_;
+  int fd_ = -1;
+  size_t header_size_ = 0;
+  std::vector<bool> done_;
+};
+
+} // namespace internal
+
+} // namespace HTTP
@@ -5,10 +5,14 @@
  */
 
 #ifndef _UNIHEADER_BUILD_
+#include <cerrno>
 #include <chrono>
+#include <exec/task.hpp>
 #include <string>
 #endif
 
+#include <falutez/falutez-codec.hpp>
+#include <falutez/falutez-download.hpp>
 #include <falutez/falutez-types.hpp>
 
 namespace HTTP {
@@ -20,6 +24,7 @@ struct GenericClientConfig {
   Headers headers;
   std::string user_agent;
   bool validate_cert = true;
+  CompressionConfig compression;
 };
 
 template <typename TConfig = GenericClientConfig> struct GenericClient {
@@ -57,6 +62,10 @@ template <typename TConfig = GenericClientConfig> struct GenericClient {
     config->user_agent = user_agent;
   }
 
+  virtual void set_compression(CompressionConfig compression) {
+    config->compression = compression;
+  }
+
   virtual std::string base_url() const { return config->base_url; }
 
   virtual std::chrono::milliseconds timeout() const { return config->timeout; }
@@ -72,8 +81,68 @@ template <typename TConfig = GenericClientConfig> struct GenericClient {
                                          __FILE__, __LINE__, __func__)};
   }
 
+  /**
+   * @brief typed request: the response body is decoded with glaze reflection
+   *        straight into @p T, skipping the XSON DOM
+   * @note  derived implementations overriding request(RequestSpec) need a
+   *        `using GenericClient::request;` to keep this overload visible
+   */
+  template <typename T>
+  exec::task<TypedResult<T>> request(RequestSpec reqParams) {
+    auto response = co_await request(std::move(reqParams));
+
+    if (!response.has_value())
+      co_return FLZ::unexpected(std::move(response.error()));
+
+    auto &details = response.value();
+
+    if (!details.status)
+      co_return FLZ::unexpected(details.status);
+
+    auto value = XSON::decode<T>(details.body.has_value()
+                                     ? details.body->data()
+                                     : std::string_view{});
+
+    if (!value.has_value())
+      co_return FLZ::unexpected(HTTP::STATUS{
+          std::pair<int16_t, std::string_view>{EBADMSG, value.error().what()}});
+
+    co_return TypedResponse<T>{.details = std::move(details),
+                               .value = std::move(value.value())};
+  }
+
+  /**
+   * @brief precompute what @p spec needs on every execution (URL, headers,
+   *        dispatch) for request(PreparedRequest, RequestOverrides)
+   */
+  virtual PreparedRequest prepare(RequestSpec spec) {
+    throw std::runtime_error{std::format("{}:{}:{}: prepare() not implemented",
+                                         __FILE__, __LINE__, __func__)};
+  }
+
+  /// execute a request from prepare() with @p overrides applied
+  virtual AsyncResponse request(PreparedRequest prepared,
+                                RequestOverrides overrides) {
+    throw std::runtime_error{std::format("{}:{}:{}: request() not implemented",
+                                         __FILE__, __LINE__, __func__)};
+  }
+
+  /**
+   * @brief fetch a (large) object into spec.destination; implementations
+   *        split it into byte ranges fetched in parallel when the server
+   *        supports them
+   */
+  virtual exec::task<Download> download(DownloadSpec spec) {
+    throw std::runtime_error{std::format("{}:{}:{}: download() not implemented",
+                                         __FILE__, __LINE__, __func__)};
+  }
+
   virtual std::string_view user_agent() const { return config->user_agent; }
 
+  virtual CompressionConfig const &compression() const {
+    return config->compression;
+  }
+
 protected:
   std::shared_ptr<TConfig> config;
 };
@@ -1,8 +1,23 @@
 #pragma once
 
 #ifndef _UNIHEADER_BUILD_
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <cerrno>
+#include <charconv>
+#include <cstring>
 #include <exec/static_thread_pool.hpp>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
 #include <restclient-cpp/connection.h>
 #include <restclient-cpp/restclient.h>
 #endif
@@ -26,6 +41,7 @@ struct RestClientClient : public GenericClient<RestClientClientConfig> {
       : GenericClient{std::make_shared<RestClientClientConfig>(params)},
         thread_pool_{params.thread_pool_size} {
     RestClient::init();
+    compile_defaults();
   }
 
   RestClientClient(RestClientClient &&) = delete;
@@ -33,155 +49,920 @@ struct RestClientClient : public GenericClient<RestClientClientConfig> {
   RestClientClient(const RestClientClient &) = delete;
   RestClientClient &operator=(const RestClientClient &) = delete;
 
+  using GenericClient::request;
+
+  // the setters that feed the default header block recompile it; workers
+  // pick the new block up on their next request
+
+  void set_headers(Headers headers) override {
+    GenericClient::set_headers(std::move(headers));
+    compile_defaults();
+  }
+
+  void set_user_agent(std::string_view user_agent) override {
+    GenericClient::set_user_agent(user_agent);
+    compile_defaults();
+  }
+
+  void set_compression(CompressionConfig compression) override {
+    GenericClient::set_compression(std::move(compression));
+    compile_defaults();
+  }
+
   AsyncResponse request(RequestSpec params) override {
     // construct a thread-local connection object for each thread in the pool.
     // and apply any necessary configuration.
 
-    if (params.path.empty() && this->config->base_url.empty()) {
+    if (params.path.empty() && !params.route.has_value() &&
+        this->config->base_url.empty()) {
       co_return FLZ::unexpected(HTTP::STATUS(
           {EINVAL, std::format("({}:{}:{}): both path and base_url empty",
                                __FILE__, __LINE__, __func__)}));
     }
 
-    auto sync_op = [this, params]() -> HTTP::ResponseDetails {
-      static thread_local RestClient::Connection conn = [this]() {
-        auto thr_conn = RestClient::Connection{config->base_url};
-        if (config->timeout.count() != 0)
-          thr_conn.SetTimeout(
-              std::chrono::duration_cast<std::chrono::seconds>(config->timeout)
-                  .count());
-        // if (config->keepalive.first) {
-        //   // curl automatically reuses connections
-        // }
-        if (!config->user_agent.empty())
-          thr_conn.SetUserAgent(config->user_agent);
-        if (!config->validate_cert)
-          thr_conn.SetVerifyPeer(false);
-#ifndef NDEBUG
-        // std::cerr << std::format(
-        //     "{}:{}:{}: threadpool connection initialized with timeout={}\n",
-        //     __FILE__, __LINE__, __func__, thr_conn.GetInfo().timeout);
-#endif
-        return thr_conn;
-      }();
+    // the spec (and the shared buffer of its body) is moved, not copied, onto
+    // the worker
+    auto sync_op = [this, params = std::move(
+                              params)]() mutable -> HTTP::ResponseDetails {
+      return perform(params);
+    };
+
+    auto sch = thread_pool_.get_scheduler();
+
+    auto [val] =
+        stdexec::sync_wait(stdexec::then(stdexec::schedule(sch), sync_op))
+            .value();
+
+    co_return std::move(val);
+  }
+
+  /**
+   * @brief resolve the target URL and compile the client defaults plus
+   *        @p spec's headers into one header block, so each execution only
+   *        loads that block (if the worker's connection does not hold it
+   *        already) and applies the overrides. Sinks and resources are
+   *        per-call: pass them in RequestOverrides.
+   */
+  PreparedRequest prepare(RequestSpec spec) override {
+    auto const defaults = defaults_.load();
+
+    auto prepared = std::make_shared<Prepared>();
+    prepared->method = spec.method;
+    prepared->path =
+        spec.route.has_value() ? spec.route->str() : std::string{spec.path};
+    append_target(prepared->url, spec);
+    prepared->has_query = prepared->url.find('?') != std::string::npos;
+    prepared->headers = std::move(spec.headers);
+    prepared->body = std::move(spec.body);
+    prepared->based_on = defaults->generation;
+
+    auto block = std::make_shared<HeaderBlock>(*defaults);
+    block->generation = next_generation();
+    if (prepared->headers.has_value()) {
+      block->headers.merge(prepared->headers.value());
+      // an Accept-Encoding of the spec's own is the caller's choice, not
+      // the negotiated default that sinks may swap for identity
+      if (prepared->headers->contains(FIELD::ACCEPT_ENCODING))
+        block->negotiates_encoding = false;
+    }
+    if (prepared->body.has_value() && !prepared->body->content_type.empty() &&
+        !block->headers.contains(FIELD::CONTENT_TYPE))
+      block->headers.set_content_type(prepared->body->content_type);
+    block->compile_fields();
+    prepared->block = std::move(block);
+
+    return PreparedRequest{
+        .method = spec.method, .client = this, .state = std::move(prepared)};
+  }
+
+  AsyncResponse request(PreparedRequest prepared,
+                        RequestOverrides overrides) override {
+    if (prepared.client != this || prepared.state == nullptr) {
+      co_return FLZ::unexpected(HTTP::STATUS(
+          {EINVAL,
+           std::format("({}:{}:{}): request was not prepared by this client",
+                       __FILE__, __LINE__, __func__)}));
+    }
+
+    auto sync_op = [this, prepared = std::move(prepared),
+                    overrides = std::move(
+                        overrides)]() mutable -> HTTP::ResponseDetails {
+      return perform(*static_cast<Prepared const *>(prepared.state.get()),
+                     overrides);
+    };
+
+    auto sch = thread_pool_.get_scheduler();
+
+    auto [val] =
+        stdexec::sync_wait(stdexec::then(stdexec::schedule(sch), sync_op))
+            .value();
 
-      ResponseDetails response{.method = params.method,
-                               .path = std::string{params.path}};
-      response.headers = config->headers;
-      response.body = std::move(params.body);
+    co_return std::move(val);
+  }
 
-      {
-        auto combined_headers = Headers{config->headers};
+  /**
+   * @brief ranged parallel download: a HEAD probe for the size and
+   *        `Accept-Ranges`, then chunk-sized `Range` GETs spread over the
+   *        pool's workers (each on its own connection), written straight
+   *        to their offsets in the mapped destination. Ranges are retried
+   *        individually and recorded in a journal so an interrupted
+   *        download resumes where it stopped. Servers without byte-range
+   *        support get a single GET.
+   * @note  retries run in rounds: workers never sleep through a backoff,
+   *        they finish the round and return to the pool, and the next
+   *        round is scheduled once the backoff has passed. Servers that
+   *        refuse HEAD are probed with a one-byte ranged GET instead. The
+   *        single GET streams to the destination as it arrives, so no
+   *        download is ever held in memory whole.
+   */
+  exec::task<Download> download(DownloadSpec spec) override {
+    if (spec.path.empty() || spec.destination.empty() ||
+        spec.chunk_size == 0) {
+      co_return FLZ::unexpected(internal::download_error(
+          EINVAL, std::format("({}:{}:{}): empty path or destination, or "
+                              "zero chunk_size",
+                              __FILE__, __LINE__, __func__)));
+    }
 
-        if (params.headers.has_value())
-          combined_headers.merge(params.headers.value());
+    auto sch = thread_pool_.get_scheduler();
 
-        conn.SetHeaders(std::move(combined_headers));
+    // ranges address the stored representation; keep codings out of it
+    auto base_headers = spec.headers.value_or(Headers{});
+    base_headers["Accept-Encoding"] = "identity";
+
+    // @p req performed on a pool worker, where the connections live
+    auto const request_once = [&](RequestSpec &req) {
+      auto [response] =
+          stdexec::sync_wait(stdexec::then(stdexec::schedule(sch),
+                                           [&]() -> HTTP::ResponseDetails {
+                                             return perform(req);
+                                           }))
+              .value();
+      return std::move(response);
+    };
+
+    // servers without byte ranges: the whole object in one GET, streamed
+    // to the destination and retried whole
+    auto const download_whole = [&]() -> Download {
+      // the destination is rewritten from scratch; a journal from an
+      // earlier ranged run no longer describes it
+      internal::DownloadJournal::discard(spec.destination);
+
+      HTTP::STATUS last;
+      for (uint32_t attempt = 0; attempt <= spec.max_retries; ++attempt) {
+        if (attempt != 0)
+          backoff(spec.retry_backoff * attempt);
+
+        auto [stored] =
+            stdexec::sync_wait(
+                stdexec::then(stdexec::schedule(sch),
+                              [&] { return fetch_whole(spec, base_headers); }))
+                .value();
+        if (stored.has_value())
+          return DownloadResult{.size = *stored,
+                                .ranges = 1,
+                                .retries = attempt,
+                                .ranged = false};
+        last = std::move(stored.error());
       }
+      return FLZ::unexpected(std::move(last));
+    };
+
+    // set when the probe's range was ignored and the whole object sent
+    bool range_ignored = false;
+
+    auto const probe = [&] {
+      auto head = RequestSpec{
+          .method = METHOD::HEAD, .path = spec.path, .headers = base_headers};
+      if (auto res = request_once(head); res.status)
+        return res;
+      // some servers refuse HEAD (405) or only serve GET; the first byte of
+      // a ranged GET carries the same metadata in Content-Range. It lands
+      // in a one-byte region, so a server that ignores the range aborts on
+      // overflow instead of sending the whole object into memory
+      std::array<std::byte, 1> first{};
+      auto first_byte = RequestSpec{.method = METHOD::GET,
+                                    .path = spec.path,
+                                    .headers = base_headers,
+                                    .sink = BodySink{first}};
+      (*first_byte.headers)["Range"] = "bytes=0-0";
+      auto res = request_once(first_byte);
+      range_ignored = first_byte.sink->overflowed() ||
+                      (res.status && res.status != STATUS::PARTIAL_CONTENT);
+      return res;
+    }();
+
+    if (range_ignored)
+      co_return download_whole();
+
+    if (!probe.status)
+      co_return FLZ::unexpected(probe.status);
+
+    auto const probe_header =
+        [&probe](FIELD field) -> std::optional<std::string> {
+      auto const *value =
+          probe.headers.has_value() ? probe.headers->find(field) : nullptr;
+      return value != nullptr ? std::make_optional<std::string>(*value)
+                              : std::nullopt;
+    };
 
-      const static std::unordered_map<
-          METHOD,
-          std::function<RestClient::Response(
-              HTTP::ResponseDetails &, RestClient::Connection &, std::string)>>
-          methods = {
-              {METHOD::GET,
-               [](auto &req, auto &conn, auto path) { return conn.get(path); }},
-              {METHOD::POST,
-               [](auto &req, auto &conn, auto path) {
-                 return conn.post(path,
-                                  req.body.has_value() ? req.body->data : "");
-               }},
-              {METHOD::PUT,
-               [](auto &req, auto &conn, auto path) {
-                 return conn.put(path,
-                                 req.body.has_value() ? req.body->data : "");
-               }},
-              {METHOD::PATCH,
-               [](auto &req, auto &conn, auto path) {
-                 return conn.patch(path,
-                                   req.body.has_value() ? req.body->data : "");
-               }},
-              {METHOD::DELETE,
-               [](auto &req, auto &conn, auto path) { return conn.del(path); }},
-              {METHOD::HEAD, [](auto &req, auto &conn,
-                                auto path) { return conn.head(path); }},
-              {METHOD::OPTIONS, [](auto &req, auto &conn,
-                                   auto path) { return conn.options(path); }},
-          };
-
-      std::string full_path;
-
-      if (auto last_char = base_url().back();
-          last_char != '/' && params.path.front() != '/') {
-        full_path += '/';
+    auto const partial = probe.status == STATUS::PARTIAL_CONTENT;
+
+    // total size: Content-Length of a HEAD, or the complete length after
+    // the '/' of a ranged GET's Content-Range ("bytes 0-0/1234")
+    std::optional<size_t> size;
+    if (auto length = partial ? probe_header(FIELD::CONTENT_RANGE)
+                              : probe_header(FIELD::CONTENT_LENGTH);
+        length.has_value()) {
+      auto digits = std::string_view{*length};
+      if (partial)
+        digits.remove_prefix(std::min(digits.rfind('/') + 1, digits.size()));
+      size_t parsed = 0;
+      if (auto [ptr, ec] = std::from_chars(
+              digits.data(), digits.data() + digits.size(), parsed);
+          ec == std::errc{} && !digits.empty())
+        size = parsed;
+    }
+
+    auto const ranged =
+        size.has_value() && *size != 0 &&
+        (partial || probe_header(FIELD::ACCEPT_RANGES).value_or("").find(
+                        "bytes") != std::string::npos);
+
+    if (!ranged)
+      co_return download_whole();
+
+    // strong validator preferred; If-Range turns a changed object into a
+    // full 200 response instead of a range of the wrong version
+    auto const validator = probe_header(FIELD::ETAG).value_or(
+        probe_header(FIELD::LAST_MODIFIED).value_or(""));
+
+    // a journal only counts if the data it vouches for is still there
+    std::error_code ec;
+    auto const intact =
+        std::filesystem::file_size(spec.destination, ec) == *size;
+
+    auto journal = internal::DownloadJournal::open(
+        spec.destination, *size, spec.chunk_size, validator,
+        spec.resume && !ec && intact);
+    if (!journal.has_value())
+      co_return FLZ::unexpected(std::move(journal.error()));
+
+    auto file = internal::MappedFile::open(spec.destination, *size);
+    if (!file.has_value())
+      co_return FLZ::unexpected(std::move(file.error()));
+
+    std::vector<size_t> pending;
+    for (size_t range = 0; range < journal->ranges(); ++range) {
+      if (!journal->done(range))
+        pending.push_back(range);
+    }
+
+    auto const workers =
+        std::min(spec.max_parallel != 0
+                     ? spec.max_parallel
+                     : static_cast<size_t>(
+                           thread_pool_.available_parallelism()),
+                 pending.size());
+
+    auto const total_pending = pending.size();
+    size_t retries = 0;
+    std::atomic<size_t> next{0};
+    std::mutex failure_mutex;
+    std::optional<HTTP::STATUS> failure;
+    std::vector<size_t> again;
+
+    for (uint32_t attempt = 0; !pending.empty(); ++attempt) {
+      if (attempt != 0) {
+        retries += pending.size();
+        backoff(spec.retry_backoff * attempt);
       }
 
-      full_path += params.path;
+      auto const last_attempt = attempt == spec.max_retries;
+      next = 0;
+
+      // each shard pulls ranges until none are left; a failed range does
+      // not stop the others, so a later resume has as little as possible
+      // to redo
+      auto fetch_shard = [&](size_t) {
+        for (auto slot = next.fetch_add(1); slot < pending.size();
+             slot = next.fetch_add(1)) {
+          auto const range = pending[slot];
+          auto const first = range * spec.chunk_size;
+          auto const out = file->bytes().subspan(
+              first, std::min(spec.chunk_size, *size - first));
+
+          auto error = fetch_range(spec, base_headers, validator, first, out);
+          // the journal may only vouch for bytes that are on disk
+          if (!error.has_value() && !file->sync(first, out.size()))
+            error = internal::download_error(
+                static_cast<int16_t>(errno),
+                std::format("({}:{}:{}): msync of range {}-{}: {}", __FILE__,
+                            __LINE__, __func__, first,
+                            first + out.size() - 1, std::strerror(errno)));
+          if (!error.has_value()) {
+            journal->mark_done(range);
+            continue;
+          }
+
+          auto lock = std::lock_guard{failure_mutex};
+          // a changed object stays changed; anything else gets another
+          // round
+          if (!last_attempt && *error != ESTALE) {
+            again.push_back(range);
+          } else if (!failure.has_value()) {
+            failure = std::move(error);
+          }
+        }
+      };
+
+      stdexec::sync_wait(stdexec::bulk(stdexec::schedule(sch),
+                                       std::min(workers, pending.size()),
+                                       fetch_shard));
+
+      if (failure.has_value())
+        co_return FLZ::unexpected(std::move(*failure));
+
+      pending = std::exchange(again, {});
+    }
+
+    journal->remove();
+
+    co_return DownloadResult{.size = *size,
+                             .ranges = journal->ranges(),
+                             .ranges_resumed = journal->ranges() -
+                                               total_pending,
+                             .retries = retries,
+                             .ranged = true};
+  }
+
+private:
+  /**
+   * @brief a header block in the form the connection takes it: for the
+   *        client defaults, config headers plus User-Agent and the
+   *        negotiated Accept-Encoding; for a prepared request, those plus
+   *        its own headers. Built once, not merged on every request.
+   */
+  struct HeaderBlock {
+    /// process-unique, never 0; identifies the block a worker last applied
+    uint64_t generation = 0;
+    /// lookup copy, for the per-request "already set?" checks
+    Headers headers;
+    /// ready to hand to the connection
+    RestClient::HeaderFields fields;
+    /// Accept-Encoding was added here rather than configured by the caller
+    bool negotiates_encoding = false;
+    /// the client's compression settings when the block was built; workers
+    /// read them from here, never from config, which the caller may be
+    /// replacing meanwhile
+    CompressionConfig compression;
+
+    void compile_fields() {
+      fields.clear();
+      for (auto const &[key, value] : headers)
+        fields.insert_or_assign(wire_name(key), std::string{value});
+    }
 
-      if (params.params.has_value()) {
-        full_path += params.params.value().get_url_component();
+    /// name @p key is overlaid under: the block's own spelling of a custom
+    /// field it already has (the connection's map is case-sensitive, so
+    /// "x-trace" over "X-Trace" would go out twice), else wire_name()
+    [[nodiscard]] std::string overlay_name(std::string_view key) const {
+      if (internal::field_of(key) == FIELD::OTHER) {
+        for (auto const &[name, value] : fields) {
+          if (internal::iequals(name, key))
+            return name;
+        }
       }
+      return wire_name(key);
+    }
+  };
+
+  /// what prepare() works out for a RequestSpec
+  struct Prepared {
+    METHOD method;
+    std::string path;
+    /// target relative to base_url, query included
+    std::string url;
+    bool has_query = false;
+    std::optional<Headers> headers;
+    std::optional<Body> body;
+    /// defaults generation the block was compiled against
+    uint64_t based_on = 0;
+    std::shared_ptr<const HeaderBlock> block;
+  };
+
+  /// well-known fields in their canonical spelling, so an overlay replaces
+  /// the default rather than adding a differently-cased duplicate
+  static std::string wire_name(std::string_view key) {
+    if (auto const field = internal::field_of(key); field != FIELD::OTHER)
+      return std::string{to_string(field)};
+    return std::string{key};
+  }
 
+  /// this pool worker's connection, configured on first use
+  RestClient::Connection &connection() {
+    static thread_local RestClient::Connection conn = [this]() {
+      auto thr_conn = RestClient::Connection{config->base_url};
+      if (config->timeout.count() != 0)
+        thr_conn.SetTimeout(
+            std::chrono::duration_cast<std::chrono::seconds>(config->timeout)
+                .count());
+      // if (config->keepalive.first) {
+      //   // curl automatically reuses connections
+      // }
+      if (!config->user_agent.empty())
+        thr_conn.SetUserAgent(config->user_agent);
+      if (!config->validate_cert)
+        thr_conn.SetVerifyPeer(false);
 #ifndef NDEBUG
-      // std::cerr << std::format("{}:{}:{}: Request: url={}\n", __FILE__,
-      //                          __LINE__, __func__, full_path);
+      // std::cerr << std::format(
+      //     "{}:{}:{}: threadpool connection initialized with timeout={}\n",
+      //     __FILE__, __LINE__, __func__, thr_conn.GetInfo().timeout);
 #endif
+      return thr_conn;
+    }();
+    return conn;
+  }
 
-      auto &req_fn = methods.at(params.method);
+  /// append the request target of @p spec (path or route, then the query)
+  /// to @p out
+  void append_target(std::string &out, RequestSpec const &spec) const {
+    if (spec.route.has_value()) {
+      // compiled routes always start with '/'; literals and the pre-escaped
+      // arguments go in with one reservation
+      spec.route->render_into(out);
+    } else {
+      if (auto const &base = config->base_url;
+          !base.empty() && base.back() != '/' && !spec.path.empty() &&
+          spec.path.front() != '/') {
+        out += '/';
+      }
 
-      response.start_time = std::chrono::system_clock::now();
-      auto res = req_fn(response, conn, full_path);
-      response.end_time = std::chrono::system_clock::now();
+      out += spec.path;
+    }
 
-      if (res.code < 100) {
-        response.status = HTTP::STATUS{std::pair<int16_t, std::string_view>(
-            res.code,
-            std::format("(curl) {}",
-                        curl_easy_strerror(static_cast<CURLcode>(res.code))))};
-        return response;
+    if (spec.params.has_value()) {
+      spec.params.value().append_url_component(out);
+    }
+  }
+
+  /// one request as execute() sees it, whether it came from a RequestSpec
+  /// or a prepared request
+  struct Exchange {
+    METHOD method;
+    /// reported in ResponseDetails::path
+    std::string path;
+    /// target relative to base_url, query included
+    std::string const &url;
+    std::optional<Body> const &body;
+    /// loaded onto the connection under the per-call headers
+    HeaderBlock const &block;
+    /// per-call fields overlaid on the block, or nullptr
+    Headers const *headers = nullptr;
+    BodySink *sink = nullptr;
+    std::pmr::memory_resource *resource = nullptr;
+  };
+
+  /// execute @p params synchronously on the calling pool worker, using that
+  /// worker's connection
+  ResponseDetails perform(RequestSpec &params) {
+    auto const defaults = defaults_.load();
+
+    url_buffer_.clear();
+    append_target(url_buffer_, params);
+
+    return execute(Exchange{
+        .method = params.method,
+        .path = params.route.has_value() ? params.route->str()
+                                         : std::string{params.path},
+        .url = url_buffer_,
+        .body = params.body,
+        .block = *defaults,
+        .headers = params.headers.has_value() ? &params.headers.value()
+                                              : nullptr,
+        .sink = params.sink.has_value() ? &params.sink.value() : nullptr,
+        .resource = params.resource});
+  }
+
+  /// execute @p prepared with @p overrides on the calling pool worker
+  ResponseDetails perform(Prepared const &prepared,
+                          RequestOverrides &overrides) {
+    auto const defaults = defaults_.load();
+
+    url_buffer_.assign(prepared.url);
+    if (overrides.params.has_value() && !overrides.params->empty()) {
+      auto const offset = url_buffer_.size();
+      overrides.params->append_url_component(url_buffer_);
+      if (prepared.has_query)
+        url_buffer_[offset] = '&';
+    }
+
+    auto const *headers = overrides.headers.has_value()
+                              ? &overrides.headers.value()
+                              : nullptr;
+    auto const *block = prepared.block.get();
+
+    // the prepared block embeds the defaults it was compiled against; if
+    // they have changed since, overlay the prepared headers on the current
+    // defaults instead
+    std::optional<Headers> restated;
+    if (prepared.based_on != defaults->generation) {
+      block = defaults.get();
+      if (prepared.headers.has_value()) {
+        restated.emplace(prepared.headers.value());
+        if (headers != nullptr)
+          restated->merge(*headers);
+        headers = &restated.value();
       }
+    }
+
+    return execute(Exchange{
+        .method = prepared.method,
+        .path = prepared.path,
+        .url = url_buffer_,
+        .body = overrides.body.has_value() ? overrides.body : prepared.body,
+        .block = *block,
+        .headers = headers,
+        .sink = overrides.sink.has_value() ? &overrides.sink.value()
+                                           : nullptr,
+        .resource = overrides.resource});
+  }
+
+  /// send @p exchange on this worker's connection and collect the response
+  ResponseDetails execute(Exchange exchange) {
+    auto &conn = connection();
+
+    auto const alloc = FLZ::allocator_type{
+        exchange.resource != nullptr ? exchange.resource
+                                     : std::pmr::get_default_resource()};
+
+    ResponseDetails response{.method = exchange.method,
+                             .path = std::move(exchange.path)};
+
+    auto const &block = exchange.block;
+    auto const &compression = block.compression;
+
+    auto const per_call_has = [&](FIELD field) {
+      return exchange.headers != nullptr && exchange.headers->contains(field);
+    };
+
+    // bytes to send: the body's own buffer, or (typed bodies) the value
+    // serialized into this worker's reusable output buffer
+    std::string const *payload = &payload_of(exchange.body);
+
+    // opt-in request body compression; sent as-is if the codec fails
+    auto request_encoding = ENCODING::IDENTITY;
+    std::string packed_payload;
+    if (compression.request_encoding != ENCODING::IDENTITY &&
+        payload->size() >= compression.min_request_size &&
+        !per_call_has(FIELD::CONTENT_ENCODING) &&
+        !block.headers.contains(FIELD::CONTENT_ENCODING)) {
+      if (auto packed = CODEC::compress(compression.request_encoding,
+                                        *payload, compression.level,
+                                        compression.dictionary.get());
+          packed.has_value()) {
+        packed_payload = std::move(packed.value());
+        payload = &packed_payload;
+        request_encoding = compression.request_encoding;
+      }
+    }
+
+    {
+      // per-call fields, overlaid on the header block already on the
+      // connection
+      auto overlay = Headers{alloc};
+
+      if (exchange.headers != nullptr)
+        overlay.merge(*exchange.headers);
+
+      // sinks get the bytes as they arrive, so there is no buffered body to
+      // decode afterwards: ask for the identity coding instead
+      if (exchange.sink != nullptr && block.negotiates_encoding &&
+          !overlay.contains(FIELD::ACCEPT_ENCODING))
+        overlay[FIELD::ACCEPT_ENCODING] = "identity";
+
+      if (request_encoding != ENCODING::IDENTITY)
+        overlay[FIELD::CONTENT_ENCODING] = CODEC::name(request_encoding);
+
+      if (exchange.body.has_value() && !exchange.body->content_type.empty() &&
+          !overlay.contains(FIELD::CONTENT_TYPE) &&
+          !block.headers.contains(FIELD::CONTENT_TYPE))
+        overlay.set_content_type(exchange.body->content_type);
+
+      // the connection keeps its header map between requests: reload the
+      // block only if it is not the one loaded last, or the last request
+      // overlaid fields on it
+      if (applied_block_ != block.generation)
+        conn.SetHeaders(block.fields);
+
+      for (auto const &[key, value] : overlay)
+        conn.AppendHeader(block.overlay_name(key), std::string{value});
+
+      applied_block_ = overlay.empty() ? block.generation : 0;
+    }
 
 #ifndef NDEBUG
-      // std::cerr << std::format("{}:{}:{}: client timeout={}; base_url={}\n",
-      //                          __FILE__, __LINE__, __func__,
-      //                          conn.GetInfo().timeout,
-      //                          conn.GetInfo().baseUrl);
-      // std::cerr << std::format("{}:{}:{}: Request: url={} -> code={}\n",
-      //                          __FILE__, __LINE__, __func__, full_path,
-      //                          res.code);
-      // for (auto &[key, value] : res.headers) {
-      //   std::cerr << std::format("{}:{}:{}: Header: <{}, {}>\n", __FILE__,
-      //                            __LINE__, __func__, key, value);
-      // }
-      // std::cerr << std::format("{}:{}:{}: Body: {}\n", __FILE__, __LINE__,
-      //                          __func__, res.body);
+    // std::cerr << std::format("{}:{}:{}: Request: url={}\n", __FILE__,
+    //                          __LINE__, __func__, exchange.url);
 #endif
 
-      response.status = res.code;
+    // bodies are received into a recycled buffer from this worker's pool
+    // rather than restclient's fresh string, or streamed into the caller's
+    // sink if there is one
+    auto const &pool = internal::BufferPool::local();
+    std::unique_ptr<std::string> received;
+
+    if (exchange.sink != nullptr) {
+      active_sink_ = exchange.sink;
+      conn.SetWriteFunction(&write_to_sink);
+    } else {
+      received = pool->acquire();
+      active_buffer_ = received.get();
+      conn.SetWriteFunction(&write_to_buffer);
+    }
 
-      response.body = HTTP::Body{res.body};
+    response.start_time = std::chrono::system_clock::now();
+    auto res = dispatch(conn, exchange.method, exchange.url, *payload);
+    response.end_time = std::chrono::system_clock::now();
+
+    active_sink_ = nullptr;
+    active_buffer_ = nullptr;
+
+    if (res.code < 100) {
+      pool->release(std::move(received));
+      if (exchange.sink != nullptr)
+        response.sink_bytes = exchange.sink->written();
+      response.status = HTTP::STATUS{std::pair<int16_t, std::string_view>(
+          res.code,
+          std::format("(curl) {}",
+                      curl_easy_strerror(static_cast<CURLcode>(res.code))))};
+      return response;
+    }
 
-      if (res.headers.contains("Content-Type")) {
-        response.body->content_type = res.headers.at("Content-Type");
+#ifndef NDEBUG
+    // std::cerr << std::format("{}:{}:{}: client timeout={}; base_url={}\n",
+    //                          __FILE__, __LINE__, __func__,
+    //                          conn.GetInfo().timeout,
+    //                          conn.GetInfo().baseUrl);
+    // std::cerr << std::format("{}:{}:{}: Request: url={} -> code={}\n",
+    //                          __FILE__, __LINE__, __func__, exchange.url,
+    //                          res.code);
+    // for (auto &[key, value] : res.headers) {
+    //   std::cerr << std::format("{}:{}:{}: Header: <{}, {}>\n", __FILE__,
+    //                            __LINE__, __func__, key, value);
+    // }
+    // std::cerr << std::format("{}:{}:{}: Body: {}\n", __FILE__, __LINE__,
+    //                          __func__, res.body);
+#endif
+
+    response.status = res.code;
+
+    // emplace, not assign: pmr containers keep their own resource on
+    // assignment
+    response.headers.emplace(res.headers, alloc);
+
+    if (exchange.sink != nullptr) {
+      // the body went to the caller's sink; report metadata only
+      response.sink_bytes = exchange.sink->written();
+    } else {
+      // shared view of the pooled buffer; it returns to the pool when the
+      // last Body referring to it is destroyed
+      response.body = HTTP::Body{pool->share(std::move(received))};
+
+      // HEAD, 204 and 304 answers describe a coded body without carrying
+      // one: there is nothing to decode
+      if (auto const *content_encoding =
+              response.headers->find(FIELD::CONTENT_ENCODING);
+          content_encoding != nullptr && compression.accept_compressed &&
+          exchange.method != METHOD::HEAD && !response.body->data().empty()) {
+        if (auto decoded = CODEC::decode(
+                *content_encoding, response.body->data(),
+                compression.dictionary.get(), compression.max_decoded_size);
+            !decoded.has_value()) {
+          response.status = std::move(decoded.error());
+        } else if (decoded.value().has_value()) {
+          response.body = HTTP::Body{std::move(*decoded.value())};
+          // the headers now describe the body as handed to the caller
+          response.headers->erase(to_string(FIELD::CONTENT_ENCODING));
+          if (response.headers->contains(FIELD::CONTENT_LENGTH))
+            response.headers->set_content_length(
+                response.body->data().size());
+        }
       }
 
-      if (!res.headers.empty()) {
-        response.headers = HTTP::Headers{res.headers};
+      if (auto const *content_type =
+              response.headers->find(FIELD::CONTENT_TYPE);
+          content_type != nullptr) {
+        response.body->content_type = *content_type;
       }
+    }
 
-      return response;
-    };
+    return response;
+  }
 
-    auto sch = thread_pool_.get_scheduler();
+  static RestClient::Response dispatch(RestClient::Connection &conn,
+                                       METHOD method, std::string const &url,
+                                       std::string const &payload) {
+    switch (method) {
+    case METHOD::GET:
+      return conn.get(url);
+    case METHOD::POST:
+      return conn.post(url, payload);
+    case METHOD::PUT:
+      return conn.put(url, payload);
+    case METHOD::PATCH:
+      return conn.patch(url, payload);
+    case METHOD::DELETE:
+      return conn.del(url);
+    case METHOD::HEAD:
+      return conn.head(url);
+    case METHOD::OPTIONS:
+      return conn.options(url);
+    default:
+      break;
+    }
+    throw std::out_of_range{std::format("({}:{}:{}) unsupported method {}",
+                                        __FILE__, __LINE__, __func__,
+                                        to_string(method))};
+  }
 
-    auto [val] =
-        stdexec::sync_wait(stdexec::then(stdexec::schedule(sch), sync_op))
-            .value();
+  /// one attempt at a `Range` GET into @p out; runs on a worker. Retries
+  /// are the caller's, in rounds
+  std::optional<HTTP::STATUS> fetch_range(DownloadSpec const &spec,
+                                          Headers const &base_headers,
+                                          std::string const &validator,
+                                          size_t first,
+                                          std::span<std::byte> out) {
+    auto headers = base_headers;
+    headers["Range"] =
+        std::format("bytes={}-{}", first, first + out.size() - 1);
+    if (!validator.empty())
+      headers["If-Range"] = validator;
+
+    // received bytes land directly at their offset in the mapping
+    auto req = RequestSpec{.method = METHOD::GET,
+                           .path = spec.path,
+                           .headers = headers,
+                           .sink = BodySink{out}};
+    auto res = perform(req);
+
+    // on an If-Range mismatch the server answers 200 with the whole new
+    // object, which overflows the range-sized region and aborts the
+    // transfer before its status is seen: more bytes than the range means
+    // the range was not honoured
+    if (!res.status && req.sink->overflowed()) {
+      return internal::download_error(
+          ESTALE,
+          std::format("({}:{}:{}): {} answered range {}-{} with more than "
+                      "{} bytes; object changed",
+                      __FILE__, __LINE__, __func__, spec.path, first,
+                      first + out.size() - 1, out.size()));
+    }
 
-    co_return val;
+    if (!res.status)
+      return std::move(res.status);
+
+    if (res.status != STATUS::PARTIAL_CONTENT) {
+      // If-Range mismatch: the object changed under us, retrying won't help
+      return internal::download_error(
+          ESTALE,
+          std::format("({}:{}:{}): {} answered range {}-{} with status {}; "
+                      "object changed",
+                      __FILE__, __LINE__, __func__, spec.path, first,
+                      first + out.size() - 1,
+                      static_cast<int16_t>(res.status)));
+    }
+
+    if (res.sink_bytes != out.size()) {
+      return internal::download_error(
+          EIO, std::format("({}:{}:{}): range {}-{} of {}: got {} bytes",
+                           __FILE__, __LINE__, __func__, first,
+                           first + out.size() - 1, spec.path,
+                           res.sink_bytes));
+    }
+
+    return std::nullopt;
   }
 
-private:
+  /// one plain GET of the whole object, written to the destination as it
+  /// arrives; runs on a worker. The size written, or why it failed, in
+  /// which case the destination is left empty rather than holding an error
+  /// page or a partial body
+  FLZ::expected<size_t, HTTP::STATUS> fetch_whole(DownloadSpec const &spec,
+                                                 Headers const &base_headers) {
+    auto const fd = ::open(spec.destination.c_str(),
+                           O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0)
+      return FLZ::unexpected(internal::download_error(
+          static_cast<int16_t>(errno),
+          std::format("({}:{}:{}): open({}): {}", __FILE__, __LINE__, __func__,
+                      spec.destination.string(), std::strerror(errno))));
+
+    auto req = RequestSpec{.method = METHOD::GET,
+                           .path = spec.path,
+                           .headers = base_headers,
+                           .sink = BodySink{fd, off_t{0}}};
+    auto res = perform(req);
+
+    if (!res.status) {
+      // nothing useful to keep; the next attempt starts from empty anyway
+      [[maybe_unused]] auto const truncated = ::ftruncate(fd, 0);
+      ::close(fd);
+      return FLZ::unexpected(std::move(res.status));
+    }
+
+    ::close(fd);
+    return res.sink_bytes;
+  }
+
+  /// wait out a retry backoff on the thread driving a download, between
+  /// rounds; pool workers are never parked in a sleep and keep serving
+  /// other requests meanwhile
+  static void backoff(std::chrono::milliseconds delay) {
+    if (delay.count() > 0)
+      std::this_thread::sleep_for(delay);
+  }
+
+  /// restclient write callback while RequestSpec::sink is set; a short
+  /// count makes curl abort the transfer with CURLE_WRITE_ERROR
+  static size_t write_to_sink(void *data, size_t size, size_t nmemb,
+                              void * /* RestClient::Response */) {
+    auto const bytes = size * nmemb;
+    return active_sink_->write({static_cast<std::byte const *>(data), bytes})
+               ? bytes
+               : 0;
+  }
+
+  /// restclient write callback for ordinary requests: append to the pooled
+  /// receive buffer
+  static size_t write_to_buffer(void *data, size_t size, size_t nmemb,
+                                void * /* RestClient::Response */) {
+    auto const bytes = size * nmemb;
+    active_buffer_->append(static_cast<char const *>(data), bytes);
+    return bytes;
+  }
+
+  /// request payload as the `std::string const &` restclient expects.
+  /// Typed bodies are serialized, and slices copied, into a per-worker
+  /// output buffer whose capacity is reused from request to request.
+  static std::string const &payload_of(std::optional<Body> const &body) {
+    static const std::string kEmpty;
+    static thread_local std::string out_buffer;
+
+    if (!body.has_value())
+      return kEmpty;
+
+    if (auto const *whole = body->as_string(); whole != nullptr)
+      return *whole;
+
+    body->serialize_into(out_buffer);
+    return out_buffer;
+  }
+
+  static uint64_t next_generation() {
+    static std::atomic<uint64_t> generations{0};
+    return ++generations;
+  }
+
+  void compile_defaults() {
+    auto block = std::make_shared<HeaderBlock>();
+    block->generation = next_generation();
+    block->headers = config->headers;
+
+    if (!config->user_agent.empty() &&
+        !block->headers.contains(FIELD::USER_AGENT))
+      block->headers[FIELD::USER_AGENT] = config->user_agent;
+
+    block->compression = config->compression;
+    auto const &compression = block->compression;
+    if (compression.accept_compressed &&
+        !block->headers.contains(FIELD::ACCEPT_ENCODING)) {
+      block->headers[FIELD::ACCEPT_ENCODING] =
+          CODEC::accept_encoding(compression.dictionary != nullptr);
+      if (compression.dictionary != nullptr)
+        block->headers[CODEC::kDictionaryHeader] =
+            std::to_string(compression.dictionary->id());
+      block->negotiates_encoding = true;
+    }
+
+    block->compile_fields();
+    defaults_.store(std::move(block));
+  }
+
+  /// current default header block; replaced wholesale by compile_defaults()
+  std::atomic<std::shared_ptr<const HeaderBlock>> defaults_;
+
+  /// generation of the header block this worker's connection holds
+  /// unmodified; 0 after a request overlaid fields on it
+  static inline thread_local uint64_t applied_block_ = 0;
+  /// this worker's URL buffer; its capacity carries over between requests
+  static inline thread_local std::string url_buffer_;
+
+  /// sink of the request in flight on this worker
+  static inline thread_local BodySink *active_sink_ = nullptr;
+  /// pooled receive buffer of the request in flight on this worker
+  static inline thread_local std::string *active_buffer_ = nullptr;
+
   // std::unique_ptr<RestClient::Connection> conn;
   exec::static_thread_pool thread_pool_;
 };
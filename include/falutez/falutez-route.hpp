@@ -0,0 +1,183 @@
+#pragma once
+
+/**
+ *  @brief  compiled route templates: `"/api/v1/users/{id}/orders"` is split
+ *          into literal pieces and placeholders at compile time; binding
+ *          arguments escapes them once, and rendering is a single pre-sized
+ *          append of literals and arguments into the URL buffer.
+ */
+
+#ifndef _UNIHEADER_BUILD_
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#endif
+
+#include <falutez/falutez-types-std.hpp>
+#include <falutez/falutez-url.hpp>
+
+namespace HTTP {
+
+/// string literal usable as a template argument
+template <size_t N> struct fixed_string {
+  char data[N]{};
+
+  constexpr fixed_string(char const (&text)[N]) {
+    std::copy_n(text, N, data);
+  }
+
+  constexpr std::string_view view() const { return {data, N - 1}; }
+};
+
+/**
+ * @brief parsed form of a route template: the literal text before each
+ *        `{placeholder}` and after the last one. Malformed templates
+ *        (unbalanced braces, empty names, no leading '/', too many
+ *        placeholders) fail to compile when parsed in a constant expression.
+ */
+struct RouteTemplate {
+  static constexpr size_t kMaxParams = 8;
+
+  /// literals[i] precedes placeholder i; literals[params] is the tail
+  std::array<std::string_view, kMaxParams + 1> literals{};
+  std::array<std::string_view, kMaxParams> names{};
+  size_t params = 0;
+  /// total bytes of literal text
+  size_t literal_size = 0;
+
+  constexpr explicit RouteTemplate(std::string_view text) {
+    if (text.empty() || text.front() != '/')
+      throw std::invalid_argument{"route template must start with '/'"};
+
+    size_t literal_start = 0;
+    for (size_t pos = 0; pos < text.size(); ++pos) {
+      if (text[pos] == '}')
+        throw std::invalid_argument{"route template: unmatched '}'"};
+      if (text[pos] != '{')
+        continue;
+
+      auto const close = text.find('}', pos);
+      if (close == std::string_view::npos)
+        throw std::invalid_argument{"route template: unmatched '{'"};
+
+      auto const name = text.substr(pos + 1, close - pos - 1);
+      if (name.empty() || name.find('{') != std::string_view::npos)
+        throw std::invalid_argument{"route template: bad placeholder"};
+      if (params == kMaxParams)
+        throw std::invalid_argument{"route template: too many placeholders"};
+
+      literals[params] = text.substr(literal_start, pos - literal_start);
+      names[params] = name;
+      ++params;
+
+      pos = close;
+      literal_start = close + 1;
+    }
+    literals[params] = text.substr(literal_start);
+
+    for (size_t idx = 0; idx <= params; ++idx)
+      literal_size += literals[idx].size();
+  }
+};
+
+/// @p Template parsed once, at compile time
+template <fixed_string Template>
+inline constexpr RouteTemplate route_template{Template.view()};
+
+/**
+ * @brief a route template with its arguments bound, ready to be rendered
+ *        into a URL. Arguments are formatted and percent-encoded (a '/' in
+ *        an id cannot add a path segment) when bound, into one buffer that
+ *        stays in the small-string buffer for typical ids.
+ */
+class Route {
+public:
+  Route() = default;
+
+  /// bytes render_into() appends
+  size_t size() const { return tmpl_->literal_size + args_.size(); }
+
+  void render_into(std::string &out) const {
+    out.reserve(out.size() + size());
+
+    size_t arg_start = 0;
+    for (size_t idx = 0; idx < tmpl_->params; ++idx) {
+      out += tmpl_->literals[idx];
+      out.append(args_, arg_start, ends_[idx] - arg_start);
+      arg_start = ends_[idx];
+    }
+    out += tmpl_->literals[tmpl_->params];
+  }
+
+  std::string str() const {
+    std::string path;
+    render_into(path);
+    return path;
+  }
+
+  RouteTemplate const &compiled() const { return *tmpl_; }
+
+  bool operator==(Route const &other) const { return str() == other.str(); }
+
+  template <fixed_string Template, typename... Args>
+  friend Route route(Args const &...args);
+
+private:
+  explicit Route(RouteTemplate const &tmpl) : tmpl_{&tmpl} {}
+
+  template <typename T> void bind(T const &value) {
+    if constexpr (std::is_same_v<T, bool>) {
+      args_ += value ? "true" : "false";
+    } else if constexpr (std::is_same_v<T, FLZ::int128_t>) {
+      std::array<char, internal::kInt128Chars> digits{};
+      args_.append(digits.data(),
+                   internal::format_int128(value, digits.data()));
+    } else if constexpr (std::is_integral_v<T>) {
+      std::array<char, internal::kInt128Chars> digits{};
+      args_.append(digits.data(),
+                   std::to_chars(digits.data(),
+                                 digits.data() + digits.size(), value)
+                       .ptr);
+    } else if constexpr (std::is_floating_point_v<T>) {
+      std::array<char, internal::kDoubleChars> digits{};
+      auto const *end =
+          internal::format_double(static_cast<double>(value), digits.data());
+      internal::append_encoded(
+          args_, {digits.data(), static_cast<size_t>(end - digits.data())});
+    } else {
+      static_assert(std::convertible_to<T const &, std::string_view>,
+                    "route arguments are numbers, bools or strings");
+      internal::append_encoded(args_, std::string_view{value});
+    }
+    ends_[bound_++] = static_cast<uint32_t>(args_.size());
+  }
+
+  RouteTemplate const *tmpl_ = &route_template<"/">;
+  std::string args_;
+  std::array<uint32_t, RouteTemplate::kMaxParams> ends_{};
+  size_t bound_ = 0;
+};
+
+/**
+ * @brief bind @p args to the placeholders of @p Template, in order:
+ *        `HTTP::route<"/api/v1/users/{id}/orders">(42)`
+ */
+template <fixed_string Template, typename... Args>
+Route route(Args const &...args) {
+  constexpr auto const &tmpl = route_template<Template>;
+  static_assert(sizeof...(Args) == tmpl.params,
+                "one argument per route placeholder");
+
+  auto bound = Route{tmpl};
+  (bound.bind(args), ...);
+  return bound;
+}
+
+} // namespace HTTP
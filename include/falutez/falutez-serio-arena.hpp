@@ -0,0 +1,1527 @@
+#pragma once
+
+/**
+ *  @brief  XSON::ARENA, a DOM whose nodes, member names and strings are
+ *          allocated from a monotonic arena owned by the document. Parsing
+ *          bump-allocates one block per container instead of a malloc per
+ *          node, and destroying a document releases the arena's few blocks
+ *          without walking the tree.
+ */
+
+#ifndef _UNIHEADER_BUILD_
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <format>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <new>
+#include <optional>
+#include <ostream>
+#include <ranges>
+#include <shared_mutex>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <variant>
+#include <vector>
+#endif
+
+#include <falutez/falutez-serio-scan.hpp>
+#include <falutez/falutez-serio.hpp>
+#include <falutez/falutez-types-std.hpp>
+
+namespace XSON {
+
+class ARENA;
+
+namespace internal {
+
+/// member name, with its hash precomputed so a lookup rejects most
+/// non-matching members on one 64-bit compare
+class ArenaKey {
+public:
+  ArenaKey() = default;
+  ArenaKey(char const *data, uint32_t size)
+      : ArenaKey{data, size, fnv1a(data, size)} {}
+  ArenaKey(char const *data, uint32_t size, uint32_t hash)
+      : data_{data}, size_{size}, hash_{hash} {}
+
+  static uint32_t fnv1a(char const *data, size_t size) noexcept {
+    uint32_t value = 2166136261U;
+    for (size_t idx = 0; idx < size; ++idx)
+      value = (value ^ static_cast<unsigned char>(data[idx])) * 16777619U;
+    return value;
+  }
+
+  [[nodiscard]] std::string_view view() const noexcept {
+    return {data_, size_};
+  }
+
+  [[nodiscard]] uint32_t hash() const noexcept { return hash_; }
+
+  operator std::string_view() const noexcept { return view(); }
+
+  operator std::string() const { return std::string{view()}; }
+
+  bool operator==(std::string_view other) const noexcept {
+    return view() == other;
+  }
+
+  bool operator==(ArenaKey const &other) const noexcept {
+    return hash_ == other.hash_ && size_ == other.size_ &&
+           std::memcmp(data_, other.data_, size_) == 0;
+  }
+
+  friend std::ostream &operator<<(std::ostream &out, ArenaKey const &key) {
+    return out << key.view();
+  }
+
+private:
+  char const *data_ = nullptr;
+  uint32_t size_ = 0;
+  uint32_t hash_ = 0;
+};
+
+static_assert(sizeof(ArenaKey) == 16);
+
+/**
+ * @brief interned member-name lists ("shapes") shared by the objects of
+ *        every document parsed with the same registry. Objects with an
+ *        interned shape store only their values; the names live here once.
+ *
+ * Thread-safe. Past @p limit distinct shapes, objects keep their own names,
+ * so hostile input cannot grow the registry without bound.
+ */
+class ArenaShapes {
+public:
+  explicit ArenaShapes(size_t limit = 4096) : limit_{limit} {}
+
+  /// the interned copy of @p keys, or nullptr once the registry is full
+  ArenaKey const *intern(ArenaKey const *keys, uint32_t count) {
+    auto const hash = shape_hash(keys, count);
+    {
+      std::shared_lock const lock{mutex_};
+      if (auto const *found = lookup(hash, keys, count))
+        return found;
+    }
+
+    std::unique_lock const lock{mutex_};
+    if (auto const *found = lookup(hash, keys, count))
+      return found;
+    if (table_.size() >= limit_)
+      return nullptr;
+
+    auto *interned = static_cast<ArenaKey *>(
+        storage_.allocate(count * sizeof(ArenaKey), alignof(ArenaKey)));
+    for (uint32_t idx = 0; idx < count; ++idx) {
+      auto const name = keys[idx].view();
+      auto *chars = static_cast<char *>(storage_.allocate(name.size(), 1));
+      std::memcpy(chars, name.data(), name.size());
+      new (interned + idx) ArenaKey{chars, static_cast<uint32_t>(name.size()),
+                                    keys[idx].hash()};
+    }
+    table_.emplace(hash, Shape{interned, count});
+    return interned;
+  }
+
+  [[nodiscard]] size_t size() const {
+    std::shared_lock const lock{mutex_};
+    return table_.size();
+  }
+
+  static uint64_t shape_hash(ArenaKey const *keys, uint32_t count) noexcept {
+    uint64_t hash = count;
+    for (uint32_t idx = 0; idx < count; ++idx)
+      hash = hash * 0x100000001b3ULL ^ keys[idx].hash();
+    return hash;
+  }
+
+  static bool same(ArenaKey const *lhs, ArenaKey const *rhs,
+                   uint32_t count) noexcept {
+    return std::equal(lhs, lhs + count, rhs);
+  }
+
+private:
+  struct Shape {
+    ArenaKey const *keys;
+    uint32_t count;
+  };
+
+  ArenaKey const *lookup(uint64_t hash, ArenaKey const *keys,
+                         uint32_t count) const {
+    auto [first, last] = table_.equal_range(hash);
+    for (; first != last; ++first) {
+      auto const &shape = first->second;
+      if (shape.count == count && same(shape.keys, keys, count))
+        return shape.keys;
+    }
+    return nullptr;
+  }
+
+  size_t limit_;
+  mutable std::shared_mutex mutex_;
+  std::unordered_multimap<uint64_t, Shape> table_;
+  std::pmr::monotonic_buffer_resource storage_;
+};
+
+/// the blocks one ARENA document allocates from
+struct Arena {
+  static constexpr size_t kMinBlock = 256;
+
+  explicit Arena(size_t initial = kMinBlock,
+                 std::shared_ptr<ArenaShapes> shapes = {})
+      : resource{std::max(initial, kMinBlock)}, shapes{std::move(shapes)} {}
+
+  template <typename T> T *allocate(size_t count = 1) {
+    return static_cast<T *>(resource.allocate(count * sizeof(T), alignof(T)));
+  }
+
+  char *copy(std::string_view text) {
+    auto *chars = allocate<char>(text.size());
+    if (!text.empty())
+      std::memcpy(chars, text.data(), text.size());
+    return chars;
+  }
+
+  std::pmr::monotonic_buffer_resource resource;
+  /// interned names this document's objects may point at
+  std::shared_ptr<ArenaShapes> shapes;
+};
+
+/**
+ * @brief a member name resolved once and reused across lookups: remembers
+ *        the slot it last matched, so objects of the same shape are hit
+ *        with one compare instead of a scan. Not for concurrent use; give
+ *        each thread its own. The remembered slot is trusted as is, so in
+ *        an object that repeats the name it may find an earlier occurrence
+ *        than at() would.
+ */
+class ArenaField {
+public:
+  explicit ArenaField(std::string name)
+      : name_{std::move(name)},
+        hash_{ArenaKey::fnv1a(name_.data(), name_.size())} {}
+
+  [[nodiscard]] std::string_view name() const noexcept { return name_; }
+
+  [[nodiscard]] ArenaKey probe() const noexcept {
+    return ArenaKey{name_.data(), static_cast<uint32_t>(name_.size()), hash_};
+  }
+
+private:
+  template <typename> friend class ArenaObject;
+
+  std::string name_;
+  uint32_t hash_;
+  mutable uint32_t slot_ = 0;
+};
+
+template <typename Value> class ArenaArray;
+template <typename Value> class ArenaObject;
+
+/// the state of one ARENA value, without its ownership rules; also what the
+/// parser accumulates before a container's children are placed
+struct ArenaNode {
+  union Payload {
+    bool boolean;
+    double real;
+    int64_t integer;
+    char *chars;
+    ArenaArray<ARENA> *array;
+    ArenaObject<ARENA> *object;
+  };
+
+  Arena *arena = nullptr;
+  Payload value{};
+  /// bytes of a string
+  uint32_t length = 0;
+  KIND kind = KIND::NUL;
+  bool is_integer = false;
+  /// lives inside its document's arena; a root (!child) deletes the arena
+  bool child = false;
+};
+
+/// elements of an ARENA array, stored in the document's arena
+template <typename Value> class ArenaArray {
+public:
+  using value_type = Value;
+  using iterator = Value *;
+  using const_iterator = Value const *;
+
+  explicit ArenaArray(Arena &arena) : arena_{&arena} {}
+
+  [[nodiscard]] size_t size() const noexcept { return size_; }
+  [[nodiscard]] bool empty() const noexcept { return size_ == 0; }
+
+  Value *begin() noexcept { return data_; }
+  Value *end() noexcept { return data_ + size_; }
+  Value const *begin() const noexcept { return data_; }
+  Value const *end() const noexcept { return data_ + size_; }
+
+  Value &operator[](size_t idx) noexcept { return data_[idx]; }
+  Value const &operator[](size_t idx) const noexcept { return data_[idx]; }
+
+  Value &at(size_t idx) {
+    return const_cast<Value &>(std::as_const(*this).at(idx));
+  }
+
+  [[nodiscard]] Value const &at(size_t idx) const {
+    if (idx >= size_)
+      throw std::out_of_range{std::format("{}:{}:{}: index {} of {}",
+                                          __FILE__, __LINE__, __func__, idx,
+                                          size_)};
+    return data_[idx];
+  }
+
+  /// grow the storage; the old block stays in the arena until the
+  /// document is destroyed
+  void reserve(size_t capacity) {
+    if (capacity <= capacity_)
+      return;
+    auto *data = arena_->template allocate<Value>(capacity);
+    for (size_t idx = 0; idx < size_; ++idx)
+      Value::relocate(data_[idx], data + idx);
+    data_ = data;
+    capacity_ = static_cast<uint32_t>(capacity);
+  }
+
+  Value &emplace_back() {
+    if (size_ == capacity_)
+      reserve(std::max<size_t>(4, size_t{capacity_} * 2));
+    return *Value::make_child(data_ + size_++, *arena_);
+  }
+
+  template <typename T> Value &emplace_back(T &&value) {
+    auto &slot = emplace_back();
+    slot.set(std::forward<T>(value));
+    return slot;
+  }
+
+  void push_back(Value const &value) { emplace_back(value); }
+
+  bool operator==(ArenaArray const &other) const {
+    return std::equal(begin(), end(), other.begin(), other.end());
+  }
+
+private:
+  friend Value;
+
+  Value *data_ = nullptr;
+  uint32_t size_ = 0;
+  uint32_t capacity_ = 0;
+  Arena *arena_ = nullptr;
+};
+
+/// members of an ARENA object: names and values in two parallel arrays, so
+/// a lookup scans contiguous names only. The names may be an interned shape
+/// shared with other objects; those are never written, and the first
+/// insertion gives the object a copy of its own.
+template <typename Value> class ArenaObject {
+  template <bool Const> class basic_iterator {
+    using value_ref = std::conditional_t<Const, Value const &, Value &>;
+    using value_ptr = std::conditional_t<Const, Value const *, Value *>;
+
+  public:
+    using value_type = std::pair<ArenaKey const &, value_ref>;
+    using reference = value_type;
+    using difference_type = std::ptrdiff_t;
+    using iterator_category = std::input_iterator_tag;
+
+    basic_iterator() = default;
+    basic_iterator(ArenaKey const *key, value_ptr value)
+        : key_{key}, value_{value} {}
+
+    reference operator*() const { return {*key_, *value_}; }
+
+    basic_iterator &operator++() {
+      ++key_;
+      ++value_;
+      return *this;
+    }
+
+    basic_iterator operator++(int) {
+      auto prev = *this;
+      ++*this;
+      return prev;
+    }
+
+    bool operator==(basic_iterator const &other) const {
+      return key_ == other.key_;
+    }
+
+  private:
+    ArenaKey const *key_ = nullptr;
+    value_ptr value_ = nullptr;
+  };
+
+public:
+  using iterator = basic_iterator<false>;
+  using const_iterator = basic_iterator<true>;
+
+  explicit ArenaObject(Arena &arena) : arena_{&arena} {}
+
+  [[nodiscard]] size_t size() const noexcept { return size_; }
+  [[nodiscard]] bool empty() const noexcept { return size_ == 0; }
+
+  iterator begin() noexcept { return {keys_, values_}; }
+  iterator end() noexcept { return {keys_ + size_, values_ + size_}; }
+  const_iterator begin() const noexcept { return {keys_, values_}; }
+  const_iterator end() const noexcept {
+    return {keys_ + size_, values_ + size_};
+  }
+
+  [[nodiscard]] Value *find(std::string_view key) noexcept {
+    return const_cast<Value *>(std::as_const(*this).find(key));
+  }
+
+  /// the last member named @p key: a repeated name resolves as in NLH
+  [[nodiscard]] Value const *find(std::string_view key) const noexcept {
+    auto const probe = ArenaKey{key.data(), static_cast<uint32_t>(key.size())};
+    for (auto idx = size_; idx-- != 0;) {
+      if (keys_[idx] == probe)
+        return values_ + idx;
+    }
+    return nullptr;
+  }
+
+  [[nodiscard]] Value *find(ArenaField const &field) noexcept {
+    return const_cast<Value *>(std::as_const(*this).find(field));
+  }
+
+  [[nodiscard]] Value const *find(ArenaField const &field) const noexcept {
+    auto const probe = field.probe();
+    if (field.slot_ < size_ && keys_[field.slot_] == probe)
+      return values_ + field.slot_;
+    for (auto idx = size_; idx-- != 0;) {
+      if (keys_[idx] == probe) {
+        field.slot_ = idx;
+        return values_ + idx;
+      }
+    }
+    return nullptr;
+  }
+
+  /// true when the names are an interned shape
+  [[nodiscard]] bool shared_shape() const noexcept {
+    return keys_ != nullptr && capacity_ == 0;
+  }
+
+  Value &operator[](std::string_view key) {
+    if (auto *value = find(key))
+      return *value;
+    return append(key);
+  }
+
+  void reserve(size_t capacity) {
+    if (capacity <= capacity_ || capacity < size_)
+      return;
+    auto *keys = arena_->template allocate<ArenaKey>(capacity);
+    auto *values = arena_->template allocate<Value>(capacity);
+    for (size_t idx = 0; idx < size_; ++idx) {
+      new (keys + idx) ArenaKey{keys_[idx]};
+      Value::relocate(values_[idx], values + idx);
+    }
+    keys_ = keys;
+    values_ = values;
+    capacity_ = static_cast<uint32_t>(capacity);
+  }
+
+  /// new null member named @p key (copied into the arena)
+  Value &append(std::string_view key) {
+    return append_shared(
+        ArenaKey{arena_->copy(key), static_cast<uint32_t>(key.size())});
+  }
+
+  /// new null member whose name already lives in this arena
+  Value &append_shared(ArenaKey key) {
+    if (size_ >= capacity_)
+      reserve(std::max<size_t>(4, size_t{size_} * 2));
+    new (keys_ + size_) ArenaKey{key};
+    return *Value::make_child(values_ + size_++, *arena_);
+  }
+
+private:
+  friend Value;
+
+  ArenaKey *keys_ = nullptr;
+  Value *values_ = nullptr;
+  uint32_t size_ = 0;
+  uint32_t capacity_ = 0;
+  Arena *arena_ = nullptr;
+};
+
+} // namespace internal
+
+/**
+ * @brief an XSON DOM allocated from a per-document arena.
+ *
+ * Values returned by operator[]/at() live in their document's arena and are
+ * valid as long as the document; copying one out (or a whole document)
+ * deep-copies into the copy's own arena. Storage replaced by assignment is
+ * reclaimed with the document, not before; reassigning a whole document
+ * starts a fresh arena. get_array()/items() expose the arena containers;
+ * array_t/object_t are the owned forms values are built from.
+ *
+ * @note objects and arrays keep their values contiguous and move them when
+ *       they grow. A reference taken before a member or element is added
+ *       still points at the old, detached copy and writes through it are
+ *       lost: take references again after inserting into their container.
+ */
+class ARENA {
+public:
+  using KIND = internal::KIND;
+  using Array = internal::ArenaArray<ARENA>;
+  using Shapes = internal::ArenaShapes;
+  using Field = internal::ArenaField;
+  using Object = internal::ArenaObject<ARENA>;
+  using array_t = std::vector<ARENA>;
+  using object_t = std::vector<std::pair<std::string, ARENA>>;
+
+  ARENA() = default;
+
+  ARENA(ARENA const &other) { set(other); }
+
+  ARENA(ARENA &&other) {
+    if (other.node_.child)
+      set(other);
+    else
+      take(other);
+  }
+
+  ARENA &operator=(ARENA const &other) {
+    if (this == &other)
+      return *this;
+    if (node_.child) {
+      set(other);
+      return *this;
+    }
+    ARENA fresh(other);
+    release();
+    take(fresh);
+    return *this;
+  }
+
+  ARENA &operator=(ARENA &&other) {
+    if (this == &other)
+      return *this;
+    if (node_.child) {
+      set(other);
+      return *this;
+    }
+    ARENA fresh(std::move(other));
+    release();
+    take(fresh);
+    return *this;
+  }
+
+  ~ARENA() { release(); }
+
+  ARENA(std::nullptr_t) {}
+
+  ARENA(bool value) { set(value); }
+
+  template <std::integral I>
+    requires(!std::same_as<I, bool>)
+  ARENA(I value) {
+    set(value);
+  }
+
+  template <std::floating_point F> ARENA(F value) { set(value); }
+
+  ARENA(FLZ::int128_t value) { set(value); }
+
+  ARENA(char const *value) { set(value); }
+
+  ARENA(std::string const &value) { set(value); }
+
+  ARENA(std::string_view value) { set(value); }
+
+  ARENA(object_t const &value) { set(value); }
+
+  template <typename T, typename... Ts>
+  ARENA(std::variant<T, Ts...> const &other) {
+    set(other);
+  }
+
+  // maps
+  template <keyed_container M>
+    requires(!std::same_as<std::remove_cvref_t<M>, ARENA>)
+  ARENA(M const &other) {
+    set(other);
+  }
+
+  // vectors and other sequences
+  template <aggregate_container R>
+    requires(!std::convertible_to<R, std::string_view> &&
+             !std::same_as<std::remove_cvref_t<R>, object_t>)
+  ARENA(R const &other) {
+    set(other);
+  }
+
+  // map-like initializer lists
+  ARENA(std::initializer_list<std::pair<
+            std::string_view,
+            std::variant<int64_t, uint64_t, int32_t, uint32_t, double, float,
+                         bool, std::string_view, std::string, const char *,
+                         ARENA>>> &&other) {
+    auto *object = make<Object>();
+    object->reserve(other.size());
+    for (auto const &[key, value] : other)
+      object->append(key).set(value);
+    node_.kind = KIND::OBJECT;
+    node_.value.object = object;
+  }
+
+  template <typename T>
+    requires(std::is_scalar_v<T>)
+  ARENA(std::initializer_list<std::initializer_list<T>> &&other) {
+    if (other.size() == 1) {
+      set_elements(*other.begin());
+      return;
+    }
+
+    auto *rows = make<Array>();
+    rows->reserve(other.size());
+    for (auto const &row : other)
+      rows->emplace_back().set_elements(row);
+    node_.kind = KIND::ARRAY;
+    node_.value.array = rows;
+  }
+
+  template <aggregate_container A> ARENA(std::initializer_list<A> &&other) {
+    if (other.size() == 1) {
+      set(*other.begin());
+      return;
+    }
+
+    auto *rows = make<Array>();
+    rows->reserve(other.size());
+    for (auto const &row : other)
+      rows->emplace_back(row);
+    node_.kind = KIND::ARRAY;
+    node_.value.array = rows;
+  }
+
+  template <typename T>
+    requires(!std::same_as<std::remove_cvref_t<T>, ARENA> &&
+             std::constructible_from<ARENA, T>)
+  ARENA &operator=(T &&other) {
+    if (node_.child)
+      set(std::forward<T>(other));
+    else
+      *this = ARENA(std::forward<T>(other));
+    return *this;
+  }
+
+  ARENA &deserialize(std::string_view str) { return deserialize(str, nullptr); }
+
+  /// parse with member names interned in @p shapes, so objects share them
+  /// with every other document parsed with the same registry
+  ARENA &deserialize(std::string_view str, std::shared_ptr<Shapes> shapes) {
+    if (node_.child) {
+      if (!arena().shapes)
+        arena().shapes = std::move(shapes);
+      if (auto const error = read(str))
+        throw parse_error(*error);
+      return *this;
+    }
+
+    auto parsed = try_parse(str, std::move(shapes));
+    if (!parsed.has_value())
+      throw std::move(parsed.error());
+    release();
+    take(*parsed);
+    return *this;
+  }
+
+  static ARENA parse(std::string_view str) {
+    ARENA json;
+    json.deserialize(str);
+    return json;
+  }
+
+  static ARENA parse(std::string_view str, std::shared_ptr<Shapes> shapes) {
+    ARENA json;
+    json.deserialize(str, std::move(shapes));
+    return json;
+  }
+
+  /// parse() that returns malformed input as an error instead of throwing
+  static FLZ::expected<ARENA, std::runtime_error>
+  try_parse(std::string_view str) {
+    return try_parse(str, nullptr);
+  }
+
+  static FLZ::expected<ARENA, std::runtime_error>
+  try_parse(std::string_view str, std::shared_ptr<Shapes> shapes) {
+    ARENA parsed;
+    parsed.node_.arena = new internal::Arena{str.size() * 2, std::move(shapes)};
+    if (auto const error = parsed.read(str))
+      return FLZ::unexpected(parse_error(*error));
+    return parsed;
+  }
+
+  [[nodiscard]] std::string serialize(bool pretty = false) const {
+    std::string out;
+    if (pretty)
+      write_pretty(out, 0);
+    else
+      write(out);
+    return out;
+  }
+
+  [[nodiscard]] KIND kind() const noexcept { return node_.kind; }
+
+  [[nodiscard]] bool is_null() const noexcept { return kind() == KIND::NUL; }
+  [[nodiscard]] bool is_boolean() const noexcept {
+    return kind() == KIND::BOOLEAN;
+  }
+  [[nodiscard]] bool is_number() const noexcept {
+    return kind() == KIND::NUMBER;
+  }
+  [[nodiscard]] bool is_string() const noexcept {
+    return kind() == KIND::STRING;
+  }
+  [[nodiscard]] bool is_array() const noexcept {
+    return kind() == KIND::ARRAY;
+  }
+  [[nodiscard]] bool is_object() const noexcept {
+    return kind() == KIND::OBJECT;
+  }
+
+  [[nodiscard]] bool is_number_integer() const noexcept {
+    return is_number() && node_.is_integer;
+  }
+
+  [[nodiscard]] bool is_number_float() const noexcept {
+    return is_number() && !node_.is_integer;
+  }
+
+  /// members of an object, elements of an array, 0 for null and 1 otherwise
+  [[nodiscard]] size_t size() const noexcept {
+    switch (kind()) {
+    case KIND::NUL:
+      return 0;
+    case KIND::ARRAY:
+      return node_.value.array->size();
+    case KIND::OBJECT:
+      return node_.value.object->size();
+    default:
+      return 1;
+    }
+  }
+
+  [[nodiscard]] bool empty() const noexcept { return size() == 0; }
+
+  [[nodiscard]] bool contains(std::string_view key) const noexcept {
+    return lookup(key) != nullptr;
+  }
+
+  /// the member @p key, or nullptr if there is none or this is not an
+  /// object: at() without the exception
+  [[nodiscard]] ARENA *find(std::string_view key) noexcept {
+    return const_cast<ARENA *>(lookup(key));
+  }
+
+  [[nodiscard]] ARENA const *find(std::string_view key) const noexcept {
+    return lookup(key);
+  }
+
+  /// lookup through a slot handle; see internal::ArenaField
+  [[nodiscard]] ARENA *find(Field const &field) noexcept {
+    return const_cast<ARENA *>(std::as_const(*this).find(field));
+  }
+
+  [[nodiscard]] ARENA const *find(Field const &field) const noexcept {
+    return is_object() ? node_.value.object->find(field) : nullptr;
+  }
+
+  [[nodiscard]] bool has_boolean_field(std::string_view key) const noexcept {
+    auto const *value = lookup(key);
+    return value != nullptr && value->is_boolean();
+  }
+
+  [[nodiscard]] bool has_double_field(std::string_view key) const noexcept {
+    auto const *value = lookup(key);
+    return value != nullptr && value->is_number_float();
+  }
+
+  [[nodiscard]] bool has_number_field(std::string_view key) const noexcept {
+    auto const *value = lookup(key);
+    return value != nullptr && value->is_number();
+  }
+
+  [[nodiscard]] bool has_string_field(std::string_view key) const noexcept {
+    auto const *value = lookup(key);
+    return value != nullptr && value->is_string();
+  }
+
+  template <std::same_as<bool> B> [[nodiscard]] B get() const {
+    if (!is_boolean())
+      throw std::runtime_error{
+          std::format("{}:{}:{}: not a boolean", __FILE__, __LINE__, __func__)};
+    return node_.value.boolean;
+  }
+
+  template <std::integral I>
+    requires(!std::same_as<I, bool>)
+  [[nodiscard]] I get() const {
+    expect_number();
+    return node_.is_integer ? static_cast<I>(node_.value.integer)
+                            : static_cast<I>(node_.value.real);
+  }
+
+  template <std::floating_point F> [[nodiscard]] F get() const {
+    expect_number();
+    return node_.is_integer ? static_cast<F>(node_.value.integer)
+                            : static_cast<F>(node_.value.real);
+  }
+
+  template <std::same_as<std::string> S> [[nodiscard]] S get() const {
+    return get_string();
+  }
+
+  template <std::same_as<std::string_view> S> [[nodiscard]] S get() const {
+    return view();
+  }
+
+  template <aggregate_container A>
+    requires(!std::is_convertible_v<A, std::string_view> &&
+             !std::is_convertible_v<A, std::string>)
+  [[nodiscard]] A get() const {
+    using elm_type = typename std::decay_t<A>::value_type;
+
+    A ret{};
+    for (auto const &elm : get_array())
+      ret.emplace_back(elm.template get<elm_type>());
+    return ret;
+  }
+
+  template <typename T> [[nodiscard]] auto coerce() const {
+    return internal::coerce_impl<ARENA, T>(*this);
+  }
+
+  template <typename T> [[nodiscard]] auto try_get() const {
+    return internal::try_get_impl<ARENA, T>(*this);
+  }
+
+  /// a copy; get<std::string_view>() reads the arena in place
+  [[nodiscard]] std::string get_string() const { return std::string{view()}; }
+
+  [[nodiscard]] Array &get_array() {
+    return const_cast<Array &>(std::as_const(*this).get_array());
+  }
+
+  [[nodiscard]] Array const &get_array() const {
+    if (!is_array())
+      throw std::runtime_error{
+          std::format("{}:{}:{}: not an array", __FILE__, __LINE__, __func__)};
+    return *node_.value.array;
+  }
+
+  [[nodiscard]] Object &get_object() {
+    return const_cast<Object &>(std::as_const(*this).get_object());
+  }
+
+  [[nodiscard]] Object const &get_object() const {
+    if (!is_object())
+      throw std::runtime_error{
+          std::format("{}:{}:{}: not an object", __FILE__, __LINE__, __func__)};
+    return *node_.value.object;
+  }
+
+  Object &items() {
+    return const_cast<Object &>(std::as_const(*this).items());
+  }
+
+  [[nodiscard]] Object const &items() const {
+    if (!is_object())
+      throw std::runtime_error{
+          std::format("{}:{}:{}: items() called on element that does not "
+                      "support enumeration",
+                      __FILE__, __LINE__, __func__)};
+    return *node_.value.object;
+  }
+
+  ARENA &operator[](std::string_view key) {
+    if (is_null()) {
+      node_.value.object = make<Object>();
+      node_.kind = KIND::OBJECT;
+    }
+    return get_object()[key];
+  }
+
+  ARENA const &operator[](std::string_view key) const { return at(key); }
+
+  /// as in NLH, an index past the end pads the array with nulls up to it
+  ARENA &operator[](std::integral auto idx) {
+    if (is_null()) {
+      node_.value.array = make<Array>();
+      node_.kind = KIND::ARRAY;
+    }
+    auto &elements = get_array();
+    auto const pos = internal::element_index(idx);
+    elements.reserve(pos + 1);
+    while (elements.size() <= pos)
+      elements.emplace_back();
+    return elements[pos];
+  }
+
+  ARENA const &operator[](std::integral auto idx) const {
+    return get_array().at(idx);
+  }
+
+  ARENA &at(std::string_view key) {
+    return const_cast<ARENA &>(std::as_const(*this).at(key));
+  }
+
+  [[nodiscard]] ARENA const &at(std::string_view key) const {
+    if (auto const *value = lookup(key))
+      return *value;
+    if (!is_object())
+      throw std::runtime_error{
+          std::format("{}:{}:{}: not an object", __FILE__, __LINE__, __func__)};
+    throw std::out_of_range{std::format("{}:{}:{}: no member '{}'", __FILE__,
+                                        __LINE__, __func__, key)};
+  }
+
+  /// lookup through a slot handle; see internal::ArenaField
+  ARENA &at(Field const &field) {
+    return const_cast<ARENA &>(std::as_const(*this).at(field));
+  }
+
+  [[nodiscard]] ARENA const &at(Field const &field) const {
+    if (!is_object())
+      throw std::runtime_error{
+          std::format("{}:{}:{}: not an object", __FILE__, __LINE__, __func__)};
+    if (auto const *value = node_.value.object->find(field))
+      return *value;
+    throw std::out_of_range{std::format("{}:{}:{}: no member '{}'", __FILE__,
+                                        __LINE__, __func__, field.name())};
+  }
+
+  ARENA &at(std::integral auto idx) { return get_array().at(idx); }
+
+  [[nodiscard]] ARENA const &at(std::integral auto idx) const {
+    return get_array().at(idx);
+  }
+
+  bool operator==(const char *other) const {
+    return is_string() && view() == other;
+  }
+
+  bool operator==(std::string_view other) const {
+    return is_string() && view() == other;
+  }
+
+  bool operator==(std::string const &other) const {
+    return is_string() && view() == other;
+  }
+
+  bool operator==(std::integral auto other) const {
+    return is_number() && get<decltype(other)>() == other;
+  }
+
+  bool operator==(std::floating_point auto other) const {
+    return is_number() && get<double>() == other;
+  }
+
+  bool operator==(bool other) const {
+    return is_boolean() && node_.value.boolean == other;
+  }
+
+  bool operator==(aggregate_container auto const &other) const {
+    if (!is_array())
+      return false;
+    auto const &self_arr = get_array();
+    return std::equal(self_arr.begin(), self_arr.end(), other.begin(),
+                      other.end());
+  }
+
+  /// deep comparison; member order does not matter
+  bool operator==(ARENA const &other) const {
+    if (kind() != other.kind())
+      return false;
+
+    switch (kind()) {
+    case KIND::NUL:
+      return true;
+    case KIND::BOOLEAN:
+      return node_.value.boolean == other.node_.value.boolean;
+    case KIND::NUMBER:
+      return node_.is_integer && other.node_.is_integer
+                 ? node_.value.integer == other.node_.value.integer
+                 : get<double>() == other.get<double>();
+    case KIND::STRING:
+      return view() == other.view();
+    case KIND::ARRAY:
+      return get_array() == other.get_array();
+    case KIND::OBJECT: {
+      if (size() != other.size())
+        return false;
+      for (auto const &[key, value] : get_object()) {
+        auto const *match = other.lookup(key);
+        if (match == nullptr || !(value == *match))
+          return false;
+      }
+      return true;
+    }
+    }
+    return false;
+  }
+
+  friend std::ostream &operator<<(std::ostream &out, ARENA const &json) {
+    return out << json.serialize();
+  }
+
+private:
+  template <typename> friend class internal::ArenaArray;
+  template <typename> friend class internal::ArenaObject;
+
+  struct child_tag {};
+
+  ARENA(child_tag, internal::ArenaNode const &node) : node_{node} {
+    node_.child = true;
+  }
+
+  /// a null value placed at @p slot, inside @p arena
+  static ARENA *make_child(ARENA *slot, internal::Arena &arena) {
+    return new (slot) ARENA(child_tag{}, internal::ArenaNode{.arena = &arena});
+  }
+
+  /// move a child to new storage in the same arena; @p from is abandoned
+  static void relocate(ARENA const &from, ARENA *to) {
+    new (to) ARENA(child_tag{}, from.node_);
+  }
+
+  internal::Arena &arena() {
+    if (node_.arena == nullptr)
+      node_.arena = new internal::Arena{};
+    return *node_.arena;
+  }
+
+  template <typename C> C *make() {
+    auto &pool = arena();
+    return new (pool.allocate<C>()) C{pool};
+  }
+
+  void release() noexcept {
+    if (!node_.child)
+      delete node_.arena;
+    node_.arena = nullptr;
+  }
+
+  /// adopt the root @p other, arena and all
+  void take(ARENA &other) noexcept {
+    node_ = std::exchange(other.node_, internal::ArenaNode{});
+    node_.child = false;
+  }
+
+  static std::runtime_error parse_error(internal::ScanError const &error) {
+    return std::runtime_error{std::format("{}:{}:{}: {} at offset {}",
+                                          __FILE__, __LINE__, __func__,
+                                          error.what, error.offset)};
+  }
+
+  void expect_number() const {
+    if (!is_number())
+      throw std::runtime_error{
+          std::format("{}:{}:{}: not a number", __FILE__, __LINE__, __func__)};
+  }
+
+  [[nodiscard]] std::string_view view() const {
+    if (!is_string())
+      throw std::runtime_error{
+          std::format("{}:{}:{}: not a string", __FILE__, __LINE__, __func__)};
+    return {node_.value.chars, node_.length};
+  }
+
+  [[nodiscard]] ARENA const *lookup(std::string_view key) const noexcept {
+    return is_object() ? node_.value.object->find(key) : nullptr;
+  }
+
+  // set(): replace the value in place, allocating from this value's arena
+
+  void set(std::nullptr_t) noexcept { node_.kind = KIND::NUL; }
+
+  void set(bool value) noexcept {
+    node_.kind = KIND::BOOLEAN;
+    node_.value.boolean = value;
+  }
+
+  template <std::integral I>
+    requires(!std::same_as<I, bool>)
+  void set(I value) noexcept {
+    node_.kind = KIND::NUMBER;
+    if constexpr (std::is_unsigned_v<I> && sizeof(I) >= sizeof(int64_t)) {
+      if (value > static_cast<I>(INT64_MAX)) {
+        node_.is_integer = false;
+        node_.value.real = static_cast<double>(value);
+        return;
+      }
+    }
+    node_.is_integer = true;
+    node_.value.integer = static_cast<int64_t>(value);
+  }
+
+  template <std::floating_point F> void set(F value) noexcept {
+    node_.kind = KIND::NUMBER;
+    node_.is_integer = false;
+    node_.value.real = static_cast<double>(value);
+  }
+
+  /// integer kind if it fits int64_t, as the parser would have read it
+  void set(FLZ::int128_t value) noexcept {
+    if (value < INT64_MIN || value > INT64_MAX)
+      set(static_cast<double>(value));
+    else
+      set(static_cast<int64_t>(value));
+  }
+
+  /// strings that fit are overwritten where they are
+  void set(std::string_view text) {
+    if (is_string() && text.size() <= node_.length) {
+      std::memmove(node_.value.chars, text.data(), text.size());
+    } else {
+      node_.value.chars = arena().copy(text);
+      node_.kind = KIND::STRING;
+    }
+    node_.length = static_cast<uint32_t>(text.size());
+  }
+
+  void set(char const *text) { set(std::string_view{text}); }
+
+  void set(std::string const &text) { set(std::string_view{text}); }
+
+  /// deep copy; names are shared when @p other is in the same arena
+  void set(ARENA const &other) {
+    if (&other == this)
+      return;
+
+    switch (other.kind()) {
+    case KIND::STRING:
+      set(other.view());
+      break;
+    case KIND::ARRAY: {
+      auto const &elements = *other.node_.value.array;
+      auto *array = make<Array>();
+      array->reserve(elements.size());
+      for (auto const &elm : elements)
+        array->emplace_back(elm);
+      node_.value.array = array;
+      node_.kind = KIND::ARRAY;
+      break;
+    }
+    case KIND::OBJECT: {
+      auto const shared = other.node_.arena == node_.arena;
+      auto const &members = *other.node_.value.object;
+      auto *object = make<Object>();
+      if (shared && members.shared_shape()) {
+        object->keys_ = members.keys_;
+        object->values_ = arena().allocate<ARENA>(members.size());
+        for (auto const &value : std::span{members.values_, members.size()})
+          make_child(object->values_ + object->size_++, arena())->set(value);
+      } else {
+        object->reserve(members.size());
+        for (auto const &[key, value] : members) {
+          auto &slot =
+              shared ? object->append_shared(key) : object->append(key);
+          slot.set(value);
+        }
+      }
+      node_.value.object = object;
+      node_.kind = KIND::OBJECT;
+      break;
+    }
+    default:
+      node_.value = other.node_.value;
+      node_.is_integer = other.node_.is_integer;
+      node_.kind = other.kind();
+    }
+  }
+
+  void set(object_t const &members) {
+    auto *object = make<Object>();
+    object->reserve(members.size());
+    for (auto const &[key, value] : members)
+      object->append(key).set(value);
+    node_.value.object = object;
+    node_.kind = KIND::OBJECT;
+  }
+
+  template <typename T, typename... Ts>
+  void set(std::variant<T, Ts...> const &other) {
+    std::visit([this](auto const &arg) { set(arg); }, other);
+  }
+
+  template <keyed_container M> void set(M const &other) {
+    auto *object = make<Object>();
+    object->reserve(std::ranges::size(other));
+    for (auto const &[key, value] : other)
+      object->append(std::string_view{key}).set(value);
+    node_.value.object = object;
+    node_.kind = KIND::OBJECT;
+  }
+
+  template <aggregate_container R>
+    requires(!std::convertible_to<R, std::string_view> &&
+             !std::same_as<std::remove_cvref_t<R>, object_t>)
+  void set(R const &other) {
+    set_elements(other);
+  }
+
+  void set_elements(auto const &range) {
+    auto *array = make<Array>();
+    if constexpr (std::ranges::sized_range<decltype(range)>)
+      array->reserve(std::ranges::size(range));
+    for (auto const &elm : range)
+      array->emplace_back(elm);
+    node_.value.array = array;
+    node_.kind = KIND::ARRAY;
+  }
+
+  /// recursive-descent parser building straight into the arena; children
+  /// collect on reusable scratch stacks until their container closes and
+  /// are then placed in one exact-sized block
+  struct Parser {
+    std::string_view text;
+    internal::Arena &arena;
+    std::vector<internal::ArenaNode> &nodes;
+    std::vector<internal::ArenaKey> &keys;
+    std::string &unescaped;
+    /// registry member names are interned in, if any
+    internal::ArenaShapes *shapes = nullptr;
+    size_t pos = 0;
+    /// shapes this parse has already interned, checked before the registry
+    std::array<std::pair<internal::ArenaKey const *, uint32_t>, 16> recent{};
+
+    std::optional<internal::ScanError> fail(std::string_view what) const {
+      return internal::ScanError{pos, what};
+    }
+
+    /// the decoded string at pos: a view of the text, or of @ref unescaped
+    std::optional<internal::ScanError> string(std::string_view &body) {
+      auto escaped = false;
+      auto const end = internal::skip_string(text, pos, &escaped);
+      if (end == std::string_view::npos)
+        return fail("unterminated string");
+
+      body = text.substr(pos + 1, end - pos - 2);
+      if (!internal::valid_string(body, escaped))
+        return fail("invalid string");
+      if (escaped) {
+        internal::unescape(body, unescaped);
+        body = unescaped;
+      }
+      pos = end;
+      return std::nullopt;
+    }
+
+    /// a member name; names headed for the registry may point into the text
+    /// until their object is placed
+    std::optional<internal::ScanError> key(internal::ArenaKey &out) {
+      std::string_view body;
+      if (auto error = string(body))
+        return error;
+      auto const length = static_cast<uint32_t>(body.size());
+      if (shapes != nullptr && body.data() != unescaped.data())
+        out = internal::ArenaKey{body.data(), length};
+      else
+        out = internal::ArenaKey{arena.copy(body), length};
+      return std::nullopt;
+    }
+
+    internal::ArenaKey const *intern(internal::ArenaKey const *names,
+                                     uint32_t count) {
+      if (shapes == nullptr || count == 0)
+        return nullptr;
+      auto &seen =
+          recent[internal::ArenaShapes::shape_hash(names, count) % recent.size()];
+      if (seen.first != nullptr && seen.second == count &&
+          internal::ArenaShapes::same(seen.first, names, count))
+        return seen.first;
+      auto const *shape = shapes->intern(names, count);
+      if (shape != nullptr)
+        seen = {shape, count};
+      return shape;
+    }
+
+    std::optional<internal::ScanError> literal(std::string_view word) {
+      if (text.substr(pos, word.size()) != word)
+        return fail("invalid literal");
+      pos += word.size();
+      return std::nullopt;
+    }
+
+    std::optional<internal::ScanError> value(internal::ArenaNode &out,
+                                             size_t depth) {
+      pos = internal::skip_ws(text, pos);
+      if (pos >= text.size())
+        return fail("unexpected end of input");
+
+      out.arena = &arena;
+      switch (text[pos]) {
+      case '{':
+        return object(out, depth + 1);
+      case '[':
+        return array(out, depth + 1);
+      case '"': {
+        std::string_view body;
+        if (auto error = string(body))
+          return error;
+        out.kind = KIND::STRING;
+        out.value.chars = arena.copy(body);
+        out.length = static_cast<uint32_t>(body.size());
+        return std::nullopt;
+      }
+      case 't':
+        out.kind = KIND::BOOLEAN;
+        out.value.boolean = true;
+        return literal("true");
+      case 'f':
+        out.kind = KIND::BOOLEAN;
+        out.value.boolean = false;
+        return literal("false");
+      case 'n':
+        out.kind = KIND::NUL;
+        return literal("null");
+      default: {
+        auto const end = internal::scan_number(text, pos);
+        if (end == std::string_view::npos)
+          return fail("unexpected character");
+        auto const number =
+            internal::parse_number(text.substr(pos, end - pos));
+        out.kind = KIND::NUMBER;
+        out.is_integer = number.is_integer;
+        if (number.is_integer)
+          out.value.integer = number.integer;
+        else
+          out.value.real = number.real;
+        pos = end;
+        return std::nullopt;
+      }
+      }
+    }
+
+    /// after an element: true at the closing @p close, false after a ','
+    std::optional<internal::ScanError> next(char close, bool &done) {
+      pos = internal::skip_ws(text, pos);
+      if (pos >= text.size())
+        return fail("unexpected end of input");
+      if (text[pos] != ',' && text[pos] != close)
+        return fail("expected ',' or closing bracket");
+      done = text[pos++] == close;
+      return std::nullopt;
+    }
+
+    std::optional<internal::ScanError> array(internal::ArenaNode &out,
+                                             size_t depth) {
+      if (depth > internal::kMaxDepth)
+        return fail("nesting too deep");
+
+      auto const mark = nodes.size();
+      pos = internal::skip_ws(text, pos + 1);
+      auto done = pos < text.size() && text[pos] == ']';
+      if (done)
+        ++pos;
+
+      while (!done) {
+        internal::ArenaNode element;
+        if (auto error = value(element, depth))
+          return error;
+        nodes.push_back(element);
+        if (auto error = next(']', done))
+          return error;
+      }
+
+      auto *array = new (arena.allocate<Array>()) Array{arena};
+      array->reserve(nodes.size() - mark);
+      for (auto idx = mark; idx < nodes.size(); ++idx)
+        new (array->data_ + array->size_++) ARENA(child_tag{}, nodes[idx]);
+      nodes.resize(mark);
+
+      out.kind = KIND::ARRAY;
+      out.value.array = array;
+      return std::nullopt;
+    }
+
+    std::optional<internal::ScanError> object(internal::ArenaNode &out,
+                                              size_t depth) {
+      if (depth > internal::kMaxDepth)
+        return fail("nesting too deep");
+
+      auto const mark = nodes.size();
+      auto const key_mark = keys.size();
+      pos = internal::skip_ws(text, pos + 1);
+      auto done = pos < text.size() && text[pos] == '}';
+      if (done)
+        ++pos;
+
+      while (!done) {
+        pos = internal::skip_ws(text, pos);
+        if (pos >= text.size() || text[pos] != '"')
+          return fail("expected object key");
+
+        if (auto error = key(keys.emplace_back()))
+          return error;
+
+        pos = internal::skip_ws(text, pos);
+        if (pos >= text.size() || text[pos] != ':')
+          return fail("expected ':'");
+        ++pos;
+
+        internal::ArenaNode member;
+        if (auto error = value(member, depth))
+          return error;
+        nodes.push_back(member);
+        if (auto error = next('}', done))
+          return error;
+      }
+
+      auto const count = static_cast<uint32_t>(nodes.size() - mark);
+      auto const *names = keys.data() + key_mark;
+      auto *object = new (arena.allocate<Object>()) Object{arena};
+      if (auto const *shape = intern(names, count)) {
+        // capacity 0 marks the names as shared
+        object->keys_ = const_cast<internal::ArenaKey *>(shape);
+        object->values_ = arena.allocate<ARENA>(count);
+      } else {
+        object->reserve(count);
+        for (uint32_t idx = 0; idx < count; ++idx) {
+          auto const name = names[idx];
+          new (object->keys_ + idx)
+              internal::ArenaKey{shapes == nullptr ? name.view().data()
+                                                   : arena.copy(name.view()),
+                                 static_cast<uint32_t>(name.view().size()),
+                                 name.hash()};
+        }
+      }
+      for (uint32_t idx = 0; idx < count; ++idx)
+        new (object->values_ + idx) ARENA(child_tag{}, nodes[mark + idx]);
+      object->size_ = count;
+      nodes.resize(mark);
+      keys.resize(key_mark);
+
+      out.kind = KIND::OBJECT;
+      out.value.object = object;
+      return std::nullopt;
+    }
+  };
+
+  /// parse @p text into this value's arena; unchanged on error
+  std::optional<internal::ScanError> read(std::string_view text) {
+    // scratch reused across parses on this thread
+    static thread_local std::vector<internal::ArenaNode> nodes;
+    static thread_local std::vector<internal::ArenaKey> keys;
+    static thread_local std::string unescaped;
+    nodes.clear();
+    keys.clear();
+
+    auto &pool = arena();
+    auto parser = Parser{text, pool, nodes, keys, unescaped, pool.shapes.get()};
+    internal::ArenaNode root;
+    if (auto error = parser.value(root, 0))
+      return error;
+    if (internal::skip_ws(text, parser.pos) != text.size()) {
+      parser.pos = internal::skip_ws(text, parser.pos);
+      return parser.fail("trailing characters");
+    }
+
+    root.child = node_.child;
+    node_ = root;
+    return std::nullopt;
+  }
+
+  void write(std::string &out) const {
+    switch (kind()) {
+    case KIND::NUL:
+      out += "null";
+      break;
+    case KIND::BOOLEAN:
+      out += node_.value.boolean ? "true" : "false";
+      break;
+    case KIND::NUMBER:
+      internal::write_number(
+          out, internal::Number{.real = node_.value.real,
+                                .integer = node_.value.integer,
+                                .is_integer = node_.is_integer});
+      break;
+    case KIND::STRING:
+      internal::escape(out, view());
+      break;
+    case KIND::ARRAY: {
+      out += '[';
+      auto separator = "";
+      for (auto const &elm : *node_.value.array) {
+        out += std::exchange(separator, ",");
+        elm.write(out);
+      }
+      out += ']';
+      break;
+    }
+    case KIND::OBJECT: {
+      out += '{';
+      auto separator = "";
+      for (auto const &[key, value] : *node_.value.object) {
+        out += std::exchange(separator, ",");
+        internal::escape(out, key);
+        out += ':';
+        value.write(out);
+      }
+      out += '}';
+      break;
+    }
+    }
+  }
+
+  /// two-space indented, as NLH::serialize(true)
+  void write_pretty(std::string &out, size_t depth) const {
+    auto const newline = [&](size_t level) {
+      out += '\n';
+      out.append(level * 2, ' ');
+    };
+
+    if (is_array() && !empty()) {
+      out += '[';
+      auto first = true;
+      for (auto const &elm : get_array()) {
+        out += std::exchange(first, false) ? "" : ",";
+        newline(depth + 1);
+        elm.write_pretty(out, depth + 1);
+      }
+      newline(depth);
+      out += ']';
+    } else if (is_object() && !empty()) {
+      out += '{';
+      auto first = true;
+      for (auto const &[key, value] : get_object()) {
+        out += std::exchange(first, false) ? "" : ",";
+        newline(depth + 1);
+        internal::escape(out, key);
+        out += ": ";
+        value.write_pretty(out, depth + 1);
+      }
+      newline(depth);
+      out += '}';
+    } else {
+      write(out);
+    }
+  }
+
+  internal::ArenaNode node_;
+};
+
+static_assert(XSON<ARENA>);
+
+} // namespace XSON
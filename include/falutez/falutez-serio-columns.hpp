@@ -0,0 +1,219 @@
+#pragma once
+
+/**
+ *  @brief  columnar extraction: named fields of every object in a JSON array
+ *          read straight from the raw text into contiguous typed vectors with
+ *          validity and null bitmaps, numbers converted with std::from_chars.
+ */
+
+#ifndef _UNIHEADER_BUILD_
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <format>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#endif
+
+#include <falutez/falutez-serio-path.hpp>
+#include <falutez/falutez-serio-scan.hpp>
+
+namespace XSON {
+
+/**
+ * @brief one field across the elements of an array: values[i] is the field
+ *        of element i, or T{} where the element lacks it. Bit i of valid is
+ *        set where the field held a T, bit i of null where it was null.
+ *
+ * A string column can be moved but not copied: a copy's values would still
+ * point into the source's unescaped strings.
+ */
+template <typename T> struct Column {
+  static_assert(std::is_same_v<T, double> || std::is_same_v<T, int64_t> ||
+                    std::is_same_v<T, std::string_view>,
+                "columns hold double, int64_t or std::string_view");
+
+  static constexpr bool kViews = std::is_same_v<T, std::string_view>;
+
+  Column() = default;
+  Column(Column const &) requires(!kViews) = default;
+  Column(Column &&) noexcept = default;
+  Column &operator=(Column const &) requires(!kViews) = default;
+  Column &operator=(Column &&) noexcept = default;
+  ~Column() = default;
+
+  std::vector<T> values;
+  std::vector<uint64_t> valid;
+  std::vector<uint64_t> null;
+  /// strings that had escapes: they cannot point into the source text, so
+  /// their values point here
+  std::deque<std::string> unescaped;
+
+  [[nodiscard]] size_t size() const noexcept { return values.size(); }
+
+  [[nodiscard]] bool is_valid(size_t idx) const noexcept {
+    return ((valid[idx / 64] >> (idx % 64)) & 1) != 0;
+  }
+
+  [[nodiscard]] bool is_null(size_t idx) const noexcept {
+    return ((null[idx / 64] >> (idx % 64)) & 1) != 0;
+  }
+
+  [[nodiscard]] size_t valid_count() const noexcept {
+    size_t count = 0;
+    for (auto const word : valid)
+      count += static_cast<size_t>(std::popcount(word));
+    return count;
+  }
+};
+
+namespace internal {
+
+/// append a row to @p column, invalid until set
+template <typename T> void add_row(Column<T> &column) {
+  if (column.values.size() % 64 == 0) {
+    column.valid.push_back(0);
+    column.null.push_back(0);
+  }
+  column.values.emplace_back();
+}
+
+/// the JSON @p token as row @p row of @p column: a value of the column's
+/// type sets it valid, null sets it null, anything else leaves it unset
+template <typename T>
+void set_cell(Column<T> &column, size_t row, std::string_view token) {
+  auto const bit = uint64_t{1} << (row % 64);
+  auto &value = column.values[row];
+  auto ok = false;
+
+  // a member repeated in the element replaces what the earlier one set,
+  // as the last duplicate does in NLH
+  column.valid[row / 64] &= ~bit;
+  column.null[row / 64] &= ~bit;
+  value = T{};
+
+  switch (kind_of(token.front())) {
+  case KIND::NUL:
+    column.null[row / 64] |= bit;
+    return;
+  case KIND::NUMBER:
+    if constexpr (std::is_same_v<T, double> || std::is_same_v<T, int64_t>) {
+      // integers must be written as integers: from_chars stops at '.' or
+      // 'e', which then leaves part of the token unread
+      auto const *const end = token.data() + token.size();
+      auto const [ptr, ec] = std::from_chars(token.data(), end, value);
+      ok = ec == std::errc{} && ptr == end &&
+           scan_number(token, 0) == token.size();
+    }
+    break;
+  case KIND::STRING:
+    if constexpr (std::is_same_v<T, std::string_view>) {
+      auto const body = token.substr(1, token.size() - 2);
+      if (auto const escaped = body.find('\\') != std::string_view::npos;
+          !valid_string(body, escaped)) {
+        // raw control characters or a malformed escape: not a valid cell
+      } else if (!escaped) {
+        value = body;
+        ok = true;
+      } else {
+        auto &decoded = column.unescaped.emplace_back();
+        unescape(body, decoded);
+        value = decoded;
+        ok = true;
+      }
+    }
+    break;
+  default:
+    break;
+  }
+
+  if (ok)
+    column.valid[row / 64] |= bit;
+  else
+    value = T{};
+}
+
+} // namespace internal
+
+/**
+ * @brief the fields @p names of every object in the array at @p array inside
+ *        the JSON @p text, one column per field, in a single pass over the
+ *        array and without building any document.
+ *
+ *   auto const [total, id] = XSON::columns<double, int64_t>(
+ *       body, XSON::Path{"/orders"}, {"total", "id"});
+ *
+ * Elements that are not objects, or lack a field, leave its row invalid; a
+ * field repeated within an element takes its last occurrence.
+ * Throws std::invalid_argument if a name is given twice, std::out_of_range
+ * if there is no array at @p array and std::runtime_error if the array is
+ * malformed.
+ */
+template <typename... Ts>
+std::tuple<Column<Ts>...>
+columns(std::string_view text, Path const &array,
+        std::array<std::string_view, sizeof...(Ts)> const &names) {
+  for (size_t field = 1; field < names.size(); ++field) {
+    if (std::ranges::find(names.begin(), names.begin() + field,
+                          names[field]) != names.begin() + field)
+      throw std::invalid_argument{
+          std::format("{}:{}:{}: field '{}' given twice", __FILE__, __LINE__,
+                      __func__, names[field])};
+  }
+
+  auto const found = array.extract(text);
+  if (!found.has_value() || found->front() != '[')
+    throw std::out_of_range{std::format("{}:{}:{}: no array at the path",
+                                        __FILE__, __LINE__, __func__)};
+  auto const elements = *found;
+
+  std::tuple<Column<Ts>...> out;
+  constexpr auto kFields = std::index_sequence_for<Ts...>{};
+
+  auto const set = [&]<size_t... I>(std::index_sequence<I...>, size_t field,
+                                    size_t row, std::string_view token) {
+    ((I == field ? internal::set_cell(std::get<I>(out), row, token) : void()),
+     ...);
+  };
+
+  std::string scratch;
+  size_t rows = 0;
+  auto const end = internal::for_each_element(elements, 0, [&](size_t pos) {
+    auto const row = rows++;
+    std::apply([](auto &...column) { (internal::add_row(column), ...); }, out);
+    if (elements[pos] != '{')
+      return internal::kSkip;
+
+    return internal::for_each_member(
+        elements, pos, scratch, [&](std::string_view key, size_t value) {
+          for (size_t field = 0; field < names.size(); ++field) {
+            if (key != names[field])
+              continue;
+            auto const value_end = internal::skip_value(elements, value);
+            if (value_end == std::string_view::npos || value_end == value)
+              return internal::kStop;
+            set(kFields, field, row,
+                elements.substr(value, value_end - value));
+            return value_end;
+          }
+          return internal::kSkip;
+        });
+  });
+
+  if (end == std::string_view::npos)
+    throw std::runtime_error{std::format("{}:{}:{}: malformed array",
+                                         __FILE__, __LINE__, __func__)};
+  return out;
+}
+
+} // namespace XSON
@@ -0,0 +1,745 @@
+#pragma once
+
+/**
+ *  @brief  XSON::LAZY, an XSON implementation that defers parsing until a
+ *          value is touched. deserialize() validates the document in one
+ *          allocation-free pass and keeps the text; a container is indexed
+ *          one level deep the first time it is accessed and a scalar is
+ *          decoded on first read. Untouched subtrees serialize straight
+ *          from the original bytes.
+ */
+
+#ifndef _UNIHEADER_BUILD_
+#include <algorithm>
+#include <concepts>
+#include <cstdint>
+#include <format>
+#include <initializer_list>
+#include <memory>
+#include <ostream>
+#include <ranges>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+#endif
+
+#include <falutez/falutez-serio-scan.hpp>
+#include <falutez/falutez-serio.hpp>
+#include <falutez/falutez-types-std.hpp>
+
+namespace XSON {
+
+namespace internal {
+
+/**
+ * @brief raw JSON text as the source of a Lazy document. Handles are views
+ *        of one value's bytes inside the validated copy the document holds.
+ */
+struct TextSource {
+  using handle = std::string_view;
+
+  struct Document {
+    std::shared_ptr<void const> holder;
+    handle root;
+  };
+
+  static FLZ::expected<Document, ScanError> parse(std::string_view text) {
+    if (auto const error = validate(text))
+      return FLZ::unexpected(*error);
+
+    auto owned = std::make_shared<std::string const>(text);
+    std::string_view const bytes = *owned;
+    auto const first = skip_ws(bytes, 0);
+    auto const root = bytes.substr(first, skip_value(bytes, first) - first);
+    return Document{std::move(owned), root};
+  }
+
+  static KIND kind(handle raw) { return kind_of(raw.front()); }
+
+  static bool boolean(handle raw) { return raw.front() == 't'; }
+
+  static Number number(handle raw) { return parse_number(raw); }
+
+  static std::string string(handle raw) { return unquote(raw); }
+
+  /// @p visit(handle) for each element of the array @p raw
+  template <typename F> static void elements(handle raw, F &&visit) {
+    auto pos = skip_ws(raw, 1);
+    while (raw[pos] != ']') {
+      auto const end = skip_value(raw, pos);
+      visit(raw.substr(pos, end - pos));
+      pos = skip_ws(raw, end);
+      if (raw[pos] == ',')
+        pos = skip_ws(raw, pos + 1);
+    }
+  }
+
+  /// @p visit(std::string key, handle) for each member of the object @p raw
+  template <typename F> static void members(handle raw, F &&visit) {
+    auto pos = skip_ws(raw, 1);
+    while (raw[pos] != '}') {
+      auto const key_end = skip_string(raw, pos);
+      auto key = unquote(raw.substr(pos, key_end - pos));
+      pos = skip_ws(raw, skip_ws(raw, key_end) + 1); // past ':'
+      auto const end = skip_value(raw, pos);
+      visit(std::move(key), raw.substr(pos, end - pos));
+      pos = skip_ws(raw, end);
+      if (raw[pos] == ',')
+        pos = skip_ws(raw, pos + 1);
+    }
+  }
+
+  static void write(handle raw, std::string &out) { minify(out, raw); }
+};
+
+/**
+ * @brief a JSON value that is either still raw (a Source handle) or
+ *        materialized. Raw values keep the source document alive through
+ *        @ref holder_, so they may outlive the document they came from.
+ *
+ * Reads expand values in place, so even const access mutates; like any
+ * other XSON value, share a document across threads only behind a lock.
+ */
+template <typename Source> class Lazy {
+  using handle_type = typename Source::handle;
+
+public:
+  using array_t = std::vector<Lazy>;
+  using object_t = std::vector<std::pair<std::string, Lazy>>;
+
+  Lazy() = default;
+  Lazy(Lazy const &) = default;
+  Lazy(Lazy &&) noexcept = default;
+  Lazy &operator=(Lazy const &) = default;
+  Lazy &operator=(Lazy &&) noexcept = default;
+  ~Lazy() = default;
+
+  Lazy(std::nullptr_t) {}
+
+  Lazy(bool value) : value_{std::in_place_type<bool>, value} {}
+
+  template <std::integral I>
+    requires(!std::same_as<I, bool>)
+  Lazy(I value) : value_{std::in_place_type<Number>, to_number(value)} {}
+
+  template <std::floating_point F>
+  Lazy(F value)
+      : value_{std::in_place_type<Number>,
+               Number{.real = static_cast<double>(value)}} {}
+
+  Lazy(FLZ::int128_t value)
+      : value_{std::in_place_type<Number>, to_number(value)} {}
+
+  Lazy(char const *value) : value_{std::in_place_type<std::string>, value} {}
+
+  Lazy(std::string value)
+      : value_{std::in_place_type<std::string>, std::move(value)} {}
+
+  Lazy(std::string_view value)
+      : value_{std::in_place_type<std::string>, value} {}
+
+  Lazy(array_t value) : value_{std::in_place_type<array_t>, std::move(value)} {}
+
+  Lazy(object_t value)
+      : value_{std::in_place_type<object_t>, std::move(value)} {}
+
+  template <typename T, typename... Ts>
+  Lazy(std::variant<T, Ts...> const &other)
+      : Lazy{std::visit([](auto const &arg) { return Lazy(arg); }, other)} {}
+
+  template <typename T, typename... Ts>
+  Lazy(std::variant<T, Ts...> &&other)
+      : Lazy{std::visit(
+            [](auto &&arg) { return Lazy(std::forward<decltype(arg)>(arg)); },
+            std::move(other))} {}
+
+  // maps
+  template <keyed_container M>
+    requires(!std::same_as<std::remove_cvref_t<M>, Lazy>)
+  Lazy(M &&other) : value_{std::in_place_type<object_t>} {
+    constexpr auto kMove = std::is_rvalue_reference_v<M &&> &&
+                           !std::is_const_v<std::remove_reference_t<M>>;
+
+    auto &members = std::get<object_t>(value_);
+    members.reserve(std::ranges::size(other));
+    for (auto &[key, value] : other) {
+      if constexpr (kMove)
+        members.emplace_back(std::string{key}, Lazy(std::move(value)));
+      else
+        members.emplace_back(std::string{key}, Lazy(value));
+    }
+  }
+
+  // vectors and other sequences
+  template <aggregate_container R>
+    requires(!std::convertible_to<R, std::string_view> &&
+             !std::same_as<std::remove_cvref_t<R>, array_t>)
+  Lazy(R &&other) : value_{std::in_place_type<array_t>} {
+    auto &elements = std::get<array_t>(value_);
+    if constexpr (std::ranges::sized_range<R>)
+      elements.reserve(std::ranges::size(other));
+    for (auto const &elm : other)
+      elements.emplace_back(elm);
+  }
+
+  // map-like initializer lists
+  Lazy(std::initializer_list<std::pair<
+           std::string_view,
+           std::variant<int64_t, uint64_t, int32_t, uint32_t, double, float,
+                        bool, std::string_view, std::string, const char *,
+                        Lazy>>> &&other)
+      : value_{std::in_place_type<object_t>} {
+    auto &members = std::get<object_t>(value_);
+    members.reserve(other.size());
+    for (auto const &[key, value] : other)
+      members.emplace_back(std::string{key}, Lazy(value));
+  }
+
+  template <typename T>
+    requires(std::is_scalar_v<T>)
+  Lazy(std::initializer_list<std::initializer_list<T>> &&other)
+      : value_{std::in_place_type<array_t>} {
+    auto &elements = std::get<array_t>(value_);
+
+    if (other.size() == 1) {
+      elements.assign(other.begin()->begin(), other.begin()->end());
+      return;
+    }
+
+    for (auto const &row : other)
+      elements.emplace_back(array_t(row.begin(), row.end()));
+  }
+
+  template <aggregate_container A> Lazy(std::initializer_list<A> &&other) {
+    if (other.size() == 1) {
+      *this = Lazy(*other.begin());
+      return;
+    }
+
+    array_t rows;
+    rows.reserve(other.size());
+    for (auto const &row : other)
+      rows.emplace_back(row);
+    value_ = std::move(rows);
+  }
+
+  template <typename T>
+    requires(!std::same_as<std::remove_cvref_t<T>, Lazy> &&
+             std::constructible_from<Lazy, T>)
+  Lazy &operator=(T &&other) {
+    return *this = Lazy(std::forward<T>(other));
+  }
+
+  Lazy &deserialize(std::string_view str) {
+    auto parsed = try_parse(str);
+    if (!parsed.has_value())
+      throw std::move(parsed.error());
+    return *this = std::move(*parsed);
+  }
+
+  static Lazy parse(std::string_view str) {
+    Lazy json;
+    json.deserialize(str);
+    return json;
+  }
+
+  /// parse() that returns malformed input as an error instead of throwing
+  static FLZ::expected<Lazy, std::runtime_error>
+  try_parse(std::string_view str) {
+    auto document = Source::parse(str);
+    if (!document.has_value())
+      return FLZ::unexpected(std::runtime_error{std::format(
+          "{}:{}:{}: {} at offset {}", __FILE__, __LINE__, __func__,
+          document.error().what, document.error().offset)});
+
+    return Lazy{raw_tag{}, document->root, std::move(document->holder)};
+  }
+
+  [[nodiscard]] std::string serialize(bool pretty = false) const {
+    std::string out;
+    if (pretty)
+      write_pretty(out, 0);
+    else
+      write(out);
+    return out;
+  }
+
+  /// kind of the value, without materializing it
+  [[nodiscard]] KIND kind() const {
+    if (auto const *raw = std::get_if<handle_type>(&value_))
+      return Source::kind(*raw);
+    return static_cast<KIND>(value_.index());
+  }
+
+  [[nodiscard]] bool is_null() const { return kind() == KIND::NUL; }
+  [[nodiscard]] bool is_boolean() const { return kind() == KIND::BOOLEAN; }
+  [[nodiscard]] bool is_number() const { return kind() == KIND::NUMBER; }
+  [[nodiscard]] bool is_string() const { return kind() == KIND::STRING; }
+  [[nodiscard]] bool is_array() const { return kind() == KIND::ARRAY; }
+  [[nodiscard]] bool is_object() const { return kind() == KIND::OBJECT; }
+
+  [[nodiscard]] bool is_number_integer() const {
+    return is_number() && number().is_integer;
+  }
+
+  [[nodiscard]] bool is_number_float() const {
+    return is_number() && !number().is_integer;
+  }
+
+  /// members of an object, elements of an array, 0 for null and 1 otherwise
+  [[nodiscard]] size_t size() const {
+    switch (kind()) {
+    case KIND::NUL:
+      return 0;
+    case KIND::ARRAY:
+      return get_array().size();
+    case KIND::OBJECT:
+      return get_object().size();
+    default:
+      return 1;
+    }
+  }
+
+  [[nodiscard]] bool empty() const { return size() == 0; }
+
+  [[nodiscard]] bool contains(std::string_view key) const {
+    return lookup(key) != nullptr;
+  }
+
+  /// the member @p key, or nullptr if there is none or this is not an
+  /// object: at() without the exception
+  [[nodiscard]] Lazy *find(std::string_view key) {
+    return const_cast<Lazy *>(lookup(key));
+  }
+
+  [[nodiscard]] Lazy const *find(std::string_view key) const {
+    return lookup(key);
+  }
+
+  [[nodiscard]] bool has_boolean_field(std::string_view key) const {
+    auto const *value = lookup(key);
+    return value != nullptr && value->is_boolean();
+  }
+
+  [[nodiscard]] bool has_double_field(std::string_view key) const {
+    auto const *value = lookup(key);
+    return value != nullptr && value->is_number_float();
+  }
+
+  [[nodiscard]] bool has_number_field(std::string_view key) const {
+    auto const *value = lookup(key);
+    return value != nullptr && value->is_number();
+  }
+
+  [[nodiscard]] bool has_string_field(std::string_view key) const {
+    auto const *value = lookup(key);
+    return value != nullptr && value->is_string();
+  }
+
+  template <std::same_as<bool> B> [[nodiscard]] B get() const {
+    expand();
+    if (auto const *value = std::get_if<bool>(&value_))
+      return *value;
+    throw std::runtime_error{
+        std::format("{}:{}:{}: not a boolean", __FILE__, __LINE__, __func__)};
+  }
+
+  template <std::integral I>
+    requires(!std::same_as<I, bool>)
+  [[nodiscard]] I get() const {
+    auto const &value = number();
+    return value.is_integer ? static_cast<I>(value.integer)
+                            : static_cast<I>(value.real);
+  }
+
+  template <std::floating_point F> [[nodiscard]] F get() const {
+    return static_cast<F>(number().real);
+  }
+
+  template <std::same_as<std::string> S> [[nodiscard]] S const &get() const {
+    return get_string();
+  }
+
+  template <std::same_as<std::string> S> [[nodiscard]] S &get() {
+    return get_string();
+  }
+
+  template <std::same_as<std::string_view> S> [[nodiscard]] S get() const {
+    return get_string();
+  }
+
+  template <aggregate_container A>
+    requires(!std::is_convertible_v<A, std::string_view> &&
+             !std::is_convertible_v<A, std::string>)
+  [[nodiscard]] A get() const {
+    using elm_type = typename std::decay_t<A>::value_type;
+
+    A ret{};
+    for (auto const &elm : get_array())
+      ret.emplace_back(elm.template get<elm_type>());
+    return ret;
+  }
+
+  template <typename T> [[nodiscard]] auto coerce() const {
+    return internal::coerce_impl<Lazy, T>(*this);
+  }
+
+  template <typename T> [[nodiscard]] auto try_get() const {
+    return internal::try_get_impl<Lazy, T>(*this);
+  }
+
+  [[nodiscard]] std::string &get_string() {
+    return const_cast<std::string &>(std::as_const(*this).get_string());
+  }
+
+  [[nodiscard]] std::string const &get_string() const {
+    expand();
+    if (auto const *value = std::get_if<std::string>(&value_))
+      return *value;
+    throw std::runtime_error{
+        std::format("{}:{}:{}: not a string", __FILE__, __LINE__, __func__)};
+  }
+
+  [[nodiscard]] array_t &get_array() {
+    return const_cast<array_t &>(std::as_const(*this).get_array());
+  }
+
+  [[nodiscard]] array_t const &get_array() const {
+    expand();
+    if (auto const *value = std::get_if<array_t>(&value_))
+      return *value;
+    throw std::runtime_error{
+        std::format("{}:{}:{}: not an array", __FILE__, __LINE__, __func__)};
+  }
+
+  [[nodiscard]] object_t &get_object() {
+    return const_cast<object_t &>(std::as_const(*this).get_object());
+  }
+
+  [[nodiscard]] object_t const &get_object() const {
+    expand();
+    if (auto const *value = std::get_if<object_t>(&value_))
+      return *value;
+    throw std::runtime_error{
+        std::format("{}:{}:{}: not an object", __FILE__, __LINE__, __func__)};
+  }
+
+  object_t &items() {
+    if (!is_object())
+      throw std::runtime_error{
+          std::format("{}:{}:{}: items() called on element that does not "
+                      "support enumeration",
+                      __FILE__, __LINE__, __func__)};
+    return get_object();
+  }
+
+  [[nodiscard]] object_t const &items() const {
+    return const_cast<Lazy &>(*this).items();
+  }
+
+  Lazy &operator[](std::string_view key) {
+    if (is_null())
+      value_.template emplace<object_t>();
+
+    auto &members = get_object();
+    // the last of a repeated name, as in NLH
+    for (auto member = members.rbegin(); member != members.rend(); ++member) {
+      if (member->first == key)
+        return member->second;
+    }
+    return members.emplace_back(std::string{key}, Lazy{}).second;
+  }
+
+  Lazy const &operator[](std::string_view key) const { return at(key); }
+
+  /// as in NLH, an index past the end pads the array with nulls up to it
+  Lazy &operator[](std::integral auto idx) {
+    if (is_null())
+      value_.template emplace<array_t>();
+    auto &elements = get_array();
+    auto const pos = internal::element_index(idx);
+    if (elements.size() <= pos)
+      elements.resize(pos + 1);
+    return elements[pos];
+  }
+
+  Lazy const &operator[](std::integral auto idx) const {
+    return get_array().at(idx);
+  }
+
+  Lazy &at(std::string_view key) {
+    return const_cast<Lazy &>(std::as_const(*this).at(key));
+  }
+
+  [[nodiscard]] Lazy const &at(std::string_view key) const {
+    if (auto const *value = lookup(key))
+      return *value;
+    if (!is_object())
+      throw std::runtime_error{
+          std::format("{}:{}:{}: not an object", __FILE__, __LINE__, __func__)};
+    throw std::out_of_range{std::format("{}:{}:{}: no member '{}'", __FILE__,
+                                        __LINE__, __func__, key)};
+  }
+
+  Lazy &at(std::integral auto idx) { return get_array().at(idx); }
+
+  [[nodiscard]] Lazy const &at(std::integral auto idx) const {
+    return get_array().at(idx);
+  }
+
+  bool operator==(const char *other) const {
+    return is_string() && get_string() == other;
+  }
+
+  bool operator==(std::string_view other) const {
+    return is_string() && get_string() == other;
+  }
+
+  bool operator==(std::string const &other) const {
+    return is_string() && get_string() == other;
+  }
+
+  bool operator==(std::integral auto other) const {
+    return is_number() && get<decltype(other)>() == other;
+  }
+
+  bool operator==(std::floating_point auto other) const {
+    return is_number() && number().real == other;
+  }
+
+  bool operator==(bool other) const {
+    return is_boolean() && get<bool>() == other;
+  }
+
+  bool operator==(aggregate_container auto const &other) const {
+    if (!is_array())
+      return false;
+    auto const &self_arr = get_array();
+    return std::equal(self_arr.begin(), self_arr.end(), other.begin(),
+                      other.end());
+  }
+
+  /// deep comparison; member order does not matter
+  bool operator==(Lazy const &other) const {
+    if (kind() != other.kind())
+      return false;
+
+    switch (kind()) {
+    case KIND::NUL:
+      return true;
+    case KIND::BOOLEAN:
+      return get<bool>() == other.get<bool>();
+    case KIND::NUMBER: {
+      auto const &lhs = number();
+      auto const &rhs = other.number();
+      return lhs.is_integer && rhs.is_integer ? lhs.integer == rhs.integer
+                                              : lhs.real == rhs.real;
+    }
+    case KIND::STRING:
+      return get_string() == other.get_string();
+    case KIND::ARRAY:
+      return get_array() == other.get_array();
+    case KIND::OBJECT: {
+      auto const &members = get_object();
+      if (members.size() != other.get_object().size())
+        return false;
+      for (auto const &[key, value] : members) {
+        auto const *match = other.lookup(key);
+        if (match == nullptr || !(value == *match))
+          return false;
+      }
+      return true;
+    }
+    }
+    return false;
+  }
+
+  friend std::ostream &operator<<(std::ostream &out, Lazy const &json) {
+    return out << json.serialize();
+  }
+
+private:
+  struct raw_tag {};
+
+  Lazy(raw_tag, handle_type raw, std::shared_ptr<void const> holder)
+      : value_{std::in_place_type<handle_type>, raw},
+        holder_{std::move(holder)} {}
+
+  template <std::integral I> static Number to_number(I value) {
+    if constexpr (std::is_unsigned_v<I> && sizeof(I) >= sizeof(int64_t)) {
+      if (value > static_cast<I>(INT64_MAX))
+        return Number{.real = static_cast<double>(value)};
+    }
+    return Number{.real = static_cast<double>(value),
+                  .integer = static_cast<int64_t>(value),
+                  .is_integer = true};
+  }
+
+  /// integer kind if it fits int64_t, as the parser would have read it
+  static Number to_number(FLZ::int128_t value) {
+    if (value < INT64_MIN || value > INT64_MAX)
+      return Number{.real = static_cast<double>(value)};
+    return Number{.real = static_cast<double>(value),
+                  .integer = static_cast<int64_t>(value),
+                  .is_integer = true};
+  }
+
+  /// materialize one level: decode a raw scalar, or index a raw container
+  /// into members/elements that are themselves still raw
+  void expand() const {
+    auto const *raw = std::get_if<handle_type>(&value_);
+    if (raw == nullptr)
+      return;
+
+    auto const handle = *raw;
+    switch (Source::kind(handle)) {
+    case KIND::NUL:
+      value_.template emplace<std::monostate>();
+      break;
+    case KIND::BOOLEAN:
+      value_.template emplace<bool>(Source::boolean(handle));
+      break;
+    case KIND::NUMBER:
+      value_.template emplace<Number>(Source::number(handle));
+      break;
+    case KIND::STRING:
+      value_.template emplace<std::string>(Source::string(handle));
+      break;
+    case KIND::ARRAY: {
+      array_t elements;
+      Source::elements(handle, [&](handle_type elm) {
+        elements.push_back(Lazy{raw_tag{}, elm, holder_});
+      });
+      value_ = std::move(elements);
+      break;
+    }
+    case KIND::OBJECT: {
+      object_t members;
+      Source::members(handle, [&](std::string key, handle_type value) {
+        members.emplace_back(std::move(key), Lazy{raw_tag{}, value, holder_});
+      });
+      value_ = std::move(members);
+      break;
+    }
+    }
+  }
+
+  Number const &number() const {
+    expand();
+    if (auto const *value = std::get_if<Number>(&value_))
+      return *value;
+    throw std::runtime_error{
+        std::format("{}:{}:{}: not a number", __FILE__, __LINE__, __func__)};
+  }
+
+  /// the last member named @p key: a repeated name resolves as in NLH
+  Lazy const *lookup(std::string_view key) const {
+    if (!is_object())
+      return nullptr;
+    auto const &members = get_object();
+    for (auto member = members.rbegin(); member != members.rend(); ++member) {
+      if (member->first == key)
+        return &member->second;
+    }
+    return nullptr;
+  }
+
+  void write(std::string &out) const {
+    if (auto const *raw = std::get_if<handle_type>(&value_)) {
+      Source::write(*raw, out);
+      return;
+    }
+
+    switch (kind()) {
+    case KIND::NUL:
+      out += "null";
+      break;
+    case KIND::BOOLEAN:
+      out += std::get<bool>(value_) ? "true" : "false";
+      break;
+    case KIND::NUMBER:
+      write_number(out, std::get<Number>(value_));
+      break;
+    case KIND::STRING:
+      escape(out, std::get<std::string>(value_));
+      break;
+    case KIND::ARRAY: {
+      out += '[';
+      auto separator = "";
+      for (auto const &elm : std::get<array_t>(value_)) {
+        out += std::exchange(separator, ",");
+        elm.write(out);
+      }
+      out += ']';
+      break;
+    }
+    case KIND::OBJECT: {
+      out += '{';
+      auto separator = "";
+      for (auto const &[key, value] : std::get<object_t>(value_)) {
+        out += std::exchange(separator, ",");
+        escape(out, key);
+        out += ':';
+        value.write(out);
+      }
+      out += '}';
+      break;
+    }
+    }
+  }
+
+  /// two-space indented, as NLH::serialize(true)
+  void write_pretty(std::string &out, size_t depth) const {
+    auto const newline = [&](size_t level) {
+      out += '\n';
+      out.append(level * 2, ' ');
+    };
+
+    if (is_array() && !empty()) {
+      out += '[';
+      auto first = true;
+      for (auto const &elm : get_array()) {
+        out += std::exchange(first, false) ? "" : ",";
+        newline(depth + 1);
+        elm.write_pretty(out, depth + 1);
+      }
+      newline(depth);
+      out += ']';
+    } else if (is_object() && !empty()) {
+      out += '{';
+      auto first = true;
+      for (auto const &[key, value] : get_object()) {
+        out += std::exchange(first, false) ? "" : ",";
+        newline(depth + 1);
+        escape(out, key);
+        out += ": ";
+        value.write_pretty(out, depth + 1);
+      }
+      newline(depth);
+      out += '}';
+    } else {
+      expand();
+      write(out);
+    }
+  }
+
+  // alternative order follows KIND; the source handle is last
+  mutable std::variant<std::monostate, bool, Number, std::string, array_t,
+                       object_t, handle_type>
+      value_;
+  /// keeps the source bytes alive for raw values
+  std::shared_ptr<void const> holder_;
+};
+
+} // namespace internal
+
+/// lazily materialized JSON over the document text
+using LAZY = internal::Lazy<internal::TextSource>;
+
+static_assert(XSON<LAZY>);
+
+} // namespace XSON
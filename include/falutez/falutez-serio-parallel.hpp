@@ -0,0 +1,351 @@
+#pragma once
+
+/**
+ *  @brief  parallel parsing of large NDJSON dumps and top-level JSON arrays:
+ *          a cheap pass finds record boundaries run by run, advanced by
+ *          whichever stdexec pool worker needs the next run, and the runs
+ *          are parsed while the pass is still going; results are gathered
+ *          in input order.
+ */
+
+#ifndef _UNIHEADER_BUILD_
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <exec/static_thread_pool.hpp>
+#include <format>
+#include <iterator>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <stdexec/execution.hpp>
+#include <string_view>
+#include <vector>
+#endif
+
+#include <falutez/falutez-serio-scan.hpp>
+#include <falutez/falutez-serio-stream.hpp>
+
+namespace XSON {
+
+namespace internal {
+
+/// how many runs to cut @p bytes of input into: a few per worker so a slow
+/// run does not hold up the rest, and none smaller than @p grain
+inline size_t run_count(size_t bytes, size_t workers, size_t grain) noexcept {
+  return std::clamp(bytes / std::max(grain, size_t{1}), size_t{1},
+                    std::max(workers, size_t{1}) * 4);
+}
+
+/// NDJSON cut into at most @p count runs of whole lines, handed out one at
+/// a time by next(). JSON strings cannot hold a raw newline, so any newline
+/// is a record boundary.
+class line_splitter {
+public:
+  line_splitter(std::string_view text, size_t count)
+      : text_{text}, target_{text.size() / count + 1} {}
+
+  /// the next run, or nullopt once the text is used up
+  std::optional<std::string_view> next() {
+    if (first_ >= text_.size())
+      return std::nullopt;
+
+    auto cut = first_ + target_;
+    if (cut < text_.size()) {
+      auto const newline = text_.find('\n', cut);
+      cut = newline == std::string_view::npos ? text_.size() : newline + 1;
+    } else {
+      cut = text_.size();
+    }
+    auto const run = text_.substr(first_, cut - first_);
+    first_ = cut;
+    return run;
+  }
+
+private:
+  std::string_view text_;
+  size_t target_;
+  size_t first_ = 0;
+};
+
+/// the elements of a top-level array cut into at most @p count runs at
+/// top-level commas, which are left out of the runs; next() scans only as
+/// far as the run it returns. Brackets, string ends and empty runs are
+/// checked here, everything else is left to the element parser.
+class array_splitter {
+public:
+  array_splitter(std::string_view text, size_t count)
+      : text_{text}, target_{text.size() / count + 1} {}
+
+  /// the next run, or nullopt after the closing bracket; throws on input
+  /// the boundary pass can tell is malformed
+  std::optional<std::string_view> next() {
+    // bytes the boundary pass has to stop at: structure, plus the commas it
+    // cuts at
+    static constexpr auto kSplit = []() {
+      auto table = kStructural;
+      table[static_cast<unsigned char>(',')] = true;
+      return table;
+    }();
+
+    if (done_)
+      return std::nullopt;
+
+    if (pos_ == std::string_view::npos) {
+      auto const open = skip_ws(text_, 0);
+      if (open >= text_.size() || text_[open] != '[')
+        fail("expected a top-level array", open);
+      pos_ = start_ = first_ = open + 1;
+    }
+
+    auto const cut = first_ + target_;
+    for (; pos_ < text_.size(); ++pos_) {
+      auto const chr = text_[pos_];
+      if (!kSplit[static_cast<unsigned char>(chr)])
+        continue;
+
+      switch (chr) {
+      case ',':
+        if (depth_ == 0 && pos_ >= cut) {
+          if (skip_ws(text_, first_) == pos_)
+            fail("expected a value", pos_);
+          auto const run = text_.substr(first_, pos_ - first_);
+          first_ = ++pos_;
+          return run;
+        }
+        break;
+      case '"': {
+        auto const end = skip_string(text_, pos_);
+        if (end == std::string_view::npos)
+          fail("unterminated string", pos_);
+        pos_ = end - 1;
+        break;
+      }
+      case '{':
+      case '[':
+        if (++depth_ > kMaxDepth)
+          fail("nesting too deep", pos_);
+        break;
+      default:
+        if (depth_-- != 0)
+          break;
+        if (chr != ']')
+          fail("expected ',' or ']'", pos_);
+        if (skip_ws(text_, pos_ + 1) != text_.size())
+          fail("trailing characters", pos_ + 1);
+        // only the run of an empty array may be blank
+        if (skip_ws(text_, first_) == pos_ && first_ != start_)
+          fail("expected a value", pos_);
+        done_ = true;
+        return text_.substr(first_, pos_ - first_);
+      }
+    }
+
+    fail("truncated input", text_.size());
+  }
+
+private:
+  [[noreturn]] static void fail(std::string_view what, size_t offset) {
+    throw std::runtime_error{std::format("{}:{}:{}: {} at offset {}", __FILE__,
+                                         __LINE__, __func__, what, offset)};
+  }
+
+  std::string_view text_;
+  size_t target_;
+  size_t pos_ = std::string_view::npos;
+  size_t start_ = 0;
+  size_t first_ = 0;
+  size_t depth_ = 0;
+  bool done_ = false;
+};
+
+/// the comma separated elements of one run of array_splitter
+template <typename T>
+void parse_elements(std::string_view run, std::vector<T> &out) {
+  auto const fail = [](std::string_view what) {
+    throw std::runtime_error{
+        std::format("{}:{}:{}: {}", __FILE__, __LINE__, __func__, what)};
+  };
+
+  auto pos = skip_ws(run, 0);
+  if (pos == run.size())
+    return;
+
+  for (;;) {
+    auto const end = skip_value(run, pos);
+    if (end == pos)
+      fail("expected a value");
+    out.push_back(parse_as<T>(run.substr(pos, end - pos)));
+
+    pos = skip_ws(run, end);
+    if (pos == run.size())
+      return;
+    if (run[pos] != ',')
+      fail("expected ','");
+    pos = skip_ws(run, pos + 1);
+    if (pos == run.size())
+      fail("expected a value");
+  }
+}
+
+/// one record per non-blank line of a run of line_splitter
+template <typename T>
+void parse_lines(std::string_view run, std::vector<T> &out) {
+  while (!run.empty()) {
+    auto const newline = run.find('\n');
+    auto line = run.substr(0, newline);
+    run.remove_prefix(newline == std::string_view::npos ? run.size()
+                                                        : newline + 1);
+
+    line.remove_prefix(std::min(skip_ws(line, 0), line.size()));
+    while (!line.empty() && is_ws(line.back()))
+      line.remove_suffix(1);
+    if (!line.empty())
+      out.push_back(parse_as<T>(line));
+  }
+}
+
+/**
+ * @brief the runs @p splitter hands out, at most @p count of them, each
+ *        parsed by @p parse_run(run, out) on @p pool and concatenated in
+ *        input order.
+ *
+ * Runs are claimed in order; a worker whose run has not been found yet
+ * advances the split itself rather than waiting on another worker, so the
+ * boundary pass overlaps the parse without any worker ever blocking on one
+ * that may not have been scheduled. A failure at some point of the input
+ * stops the claims after it but not before it, so the error rethrown is the
+ * one earliest in the input; a split error sits after every run published
+ * before it.
+ */
+template <typename T, typename Splitter, typename Parse>
+std::vector<T> parse_runs(size_t count, exec::static_thread_pool &pool,
+                          Splitter splitter, Parse const &parse_run) {
+  std::vector<std::string_view> runs(count);
+  std::vector<std::vector<T>> parsed(count);
+  // one more slot for a split error found once every run is published
+  std::vector<std::exception_ptr> errors(count + 1);
+  std::atomic<size_t> published{0};
+  std::atomic<size_t> next{0};
+  /// the earliest index with an error, nothing at or past it is claimed
+  std::atomic<size_t> failed_at{count + 1};
+  /// guards splitter and split_over, and the writes to runs
+  std::mutex split_mutex;
+  bool split_over = false;
+
+  auto const fail = [&](size_t idx) {
+    errors[idx] = std::current_exception();
+    for (auto seen = failed_at.load();
+         idx < seen && !failed_at.compare_exchange_weak(seen, idx);) {
+    }
+  };
+
+  // false once it is certain run @p idx will never be published
+  auto const reach = [&](size_t idx) {
+    while (published.load(std::memory_order_acquire) <= idx) {
+      std::lock_guard const lock{split_mutex};
+      auto const ready = published.load(std::memory_order_relaxed);
+      if (ready > idx)
+        break;
+      if (split_over)
+        return false;
+      try {
+        auto const run = splitter.next();
+        if (!run) {
+          split_over = true;
+          return false;
+        }
+        if (ready == count)
+          throw std::runtime_error{std::format(
+              "{}:{}:{}: too many runs", __FILE__, __LINE__, __func__)};
+        runs[ready] = *run;
+        published.store(ready + 1, std::memory_order_release);
+      } catch (...) {
+        split_over = true;
+        fail(ready);
+        return false;
+      }
+    }
+    return true;
+  };
+
+  auto shard = [&](size_t /*worker*/) {
+    for (;;) {
+      auto const idx = next.fetch_add(1);
+      if (idx >= failed_at.load() || !reach(idx))
+        return;
+      try {
+        parse_run(runs[idx], parsed[idx]);
+      } catch (...) {
+        fail(idx);
+      }
+    }
+  };
+
+  auto const workers =
+      std::min(static_cast<size_t>(pool.available_parallelism()), count);
+  if (workers <= 1) {
+    shard(0);
+  } else {
+    stdexec::sync_wait(
+        stdexec::bulk(stdexec::schedule(pool.get_scheduler()), workers, shard));
+  }
+
+  for (auto const &error : errors) {
+    if (error)
+      std::rethrow_exception(error);
+  }
+
+  size_t total = 0;
+  for (auto const &run : parsed)
+    total += run.size();
+
+  std::vector<T> out;
+  out.reserve(total);
+  for (auto &run : parsed)
+    std::ranges::move(run, std::back_inserter(out));
+  return out;
+}
+
+} // namespace internal
+
+/**
+ * @brief the elements of the top-level array @p text, each parsed as an XSON
+ *        value or decoded into a reflectable struct, in input order. Work is
+ *        split across @p pool in runs of at least @p grain bytes.
+ */
+template <typename T>
+std::vector<T> parse_array(std::string_view text,
+                           exec::static_thread_pool &pool,
+                           size_t grain = size_t{1} << 16) {
+  auto const count =
+      internal::run_count(text.size(), pool.available_parallelism(), grain);
+  return internal::parse_runs<T>(
+      count, pool,
+      internal::array_splitter{text, count},
+      [](std::string_view run, std::vector<T> &out) {
+        internal::parse_elements(run, out);
+      });
+}
+
+/**
+ * @brief the records of the NDJSON @p text, one per non-blank line, parsed
+ *        as in parse_array()
+ */
+template <typename T>
+std::vector<T> parse_ndjson(std::string_view text,
+                            exec::static_thread_pool &pool,
+                            size_t grain = size_t{1} << 16) {
+  auto const count =
+      internal::run_count(text.size(), pool.available_parallelism(), grain);
+  return internal::parse_runs<T>(
+      count, pool,
+      internal::line_splitter{text, count},
+      [](std::string_view run, std::vector<T> &out) {
+        internal::parse_lines(run, out);
+      });
+}
+
+} // namespace XSON
@@ -0,0 +1,274 @@
+#pragma once
+
+/**
+ *  @brief  compiled JSON Pointers (RFC 6901): parsed once, then evaluated
+ *          against any XSON value or extracted straight from raw JSON text
+ *          without building a document, one path or many in a single scan.
+ */
+
+#ifndef _UNIHEADER_BUILD_
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <limits>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+#endif
+
+#include <falutez/falutez-serio-scan.hpp>
+#include <falutez/falutez-serio.hpp>
+
+namespace XSON {
+
+/**
+ * @brief a JSON Pointer such as "/data/items/3/price", split and unescaped
+ *        once.
+ *
+ *   auto const price = XSON::Path{"/data/items/3/price"};
+ *   if (auto const *value = price.find(doc))       // any XSON value
+ *     total += value->get<double>();
+ *   auto const raw = price.extract(body);           // "12.5", no document
+ *
+ * An empty pointer refers to the whole document. A token made only of
+ * digits (without a leading zero) also indexes arrays.
+ */
+class Path {
+public:
+  struct Token {
+    std::string key;
+    /// the array index the token spells, if any
+    std::optional<size_t> index;
+  };
+
+  Path() = default;
+
+  /// throws std::runtime_error unless @p pointer is a valid JSON Pointer
+  explicit Path(std::string_view pointer) {
+    if (pointer.empty())
+      return;
+    if (pointer.front() != '/')
+      fail(pointer, "must start with '/'");
+
+    for (size_t first = 1;;) {
+      auto const slash = pointer.find('/', first);
+      auto const raw = pointer.substr(first, slash - first);
+
+      Token token;
+      token.key.reserve(raw.size());
+      for (size_t pos = 0; pos < raw.size(); ++pos) {
+        if (raw[pos] != '~') {
+          token.key += raw[pos];
+        } else if (pos + 1 < raw.size() && raw[pos + 1] == '0') {
+          token.key += '~';
+          ++pos;
+        } else if (pos + 1 < raw.size() && raw[pos + 1] == '1') {
+          token.key += '/';
+          ++pos;
+        } else {
+          fail(pointer, "'~' must be followed by '0' or '1'");
+        }
+      }
+      token.index = index_of(token.key);
+      tokens_.push_back(std::move(token));
+
+      if (slash == std::string_view::npos)
+        break;
+      first = slash + 1;
+    }
+  }
+
+  [[nodiscard]] std::span<Token const> tokens() const noexcept {
+    return tokens_;
+  }
+
+  /**
+   * @brief the value @p root refers to along this path, or nullptr if a hop
+   *        is missing or has the wrong kind. Never throws for a missing
+   *        path, never builds a key string, and looks each member up once.
+   */
+  template <typename T> T *find(T &root) const {
+    static_assert(XSON<std::remove_const_t<T>>);
+
+    auto *node = &root;
+    for (auto const &token : tokens_) {
+      if (node->is_array()) {
+        if (!token.index.has_value() || *token.index >= node->size())
+          return nullptr;
+        node = &node->at(*token.index);
+      } else {
+        node = node->find(std::string_view{token.key});
+        if (node == nullptr)
+          return nullptr;
+      }
+    }
+    return node;
+  }
+
+  /**
+   * @brief the text of the value this path refers to inside the JSON
+   *        @p text, found by skipping over everything off the path. Nothing
+   *        is materialized or validated beyond what the walk needs;
+   *        nullopt if the path does not resolve or the text is malformed.
+   */
+  [[nodiscard]] std::optional<std::string_view>
+  extract(std::string_view text) const {
+    auto pos = internal::skip_ws(text, 0);
+    std::string scratch;
+
+    for (auto const &token : tokens_) {
+      if (pos >= text.size())
+        return std::nullopt;
+
+      auto found = std::string_view::npos;
+      if (text[pos] == '{') {
+        internal::for_each_member(
+            text, pos, scratch, [&](std::string_view key, size_t value) {
+              if (key != token.key)
+                return internal::kSkip;
+              found = value;
+              return internal::kStop;
+            });
+      } else if (text[pos] == '[' && token.index.has_value()) {
+        size_t idx = 0;
+        internal::for_each_element(text, pos, [&](size_t value) {
+          if (idx++ != *token.index)
+            return internal::kSkip;
+          found = value;
+          return internal::kStop;
+        });
+      }
+      if (found == std::string_view::npos)
+        return std::nullopt;
+      pos = found;
+    }
+    return value_at(text, pos);
+  }
+
+  /**
+   * @brief extract() for every path in @p paths from one scan of @p text:
+   *        each object and array on the way is walked once however many
+   *        paths go through it, and the scan stops as soon as every path
+   *        has resolved. Results are in the order of @p paths.
+   */
+  [[nodiscard]] static std::vector<std::optional<std::string_view>>
+  extract(std::span<Path const> paths, std::string_view text) {
+    std::vector<std::optional<std::string_view>> found(paths.size());
+    std::vector<uint32_t> active(paths.size());
+    for (uint32_t idx = 0; idx < active.size(); ++idx)
+      active[idx] = idx;
+
+    auto remaining = paths.size();
+    std::string scratch;
+    walk(paths, text, internal::skip_ws(text, 0), 0, active, found, remaining,
+         scratch);
+    return found;
+  }
+
+private:
+  [[noreturn]] static void fail(std::string_view pointer,
+                                std::string_view what) {
+    throw std::runtime_error{std::format("{}:{}:{}: bad JSON pointer \"{}\": {}",
+                                         __FILE__, __LINE__, __func__, pointer,
+                                         what)};
+  }
+
+  /// "0", or digits without a leading zero
+  static std::optional<size_t> index_of(std::string_view key) noexcept {
+    if (key.empty() || (key.size() > 1 && key.front() == '0'))
+      return std::nullopt;
+    size_t index = 0;
+    for (auto chr : key) {
+      if (chr < '0' || chr > '9' ||
+          index > (std::numeric_limits<size_t>::max() - 9) / 10)
+        return std::nullopt;
+      index = index * 10 + static_cast<size_t>(chr - '0');
+    }
+    return index;
+  }
+
+  /// the text of the value starting at @p pos, if it is terminated
+  static std::optional<std::string_view> value_at(std::string_view text,
+                                                  size_t pos) {
+    if (pos >= text.size())
+      return std::nullopt;
+    auto const end = internal::skip_value(text, pos);
+    if (end == std::string_view::npos || end == pos)
+      return std::nullopt;
+    return text.substr(pos, end - pos);
+  }
+
+  /// the value at @p pos for the @p active paths, whose first @p depth tokens
+  /// led here. Returns the end of the value, or npos to stop the scan (all
+  /// paths resolved, or malformed text).
+  static size_t walk(std::span<Path const> paths, std::string_view text,
+                     size_t pos, size_t depth,
+                     std::span<uint32_t const> active,
+                     std::vector<std::optional<std::string_view>> &found,
+                     size_t &remaining, std::string &scratch) {
+    if (pos >= text.size())
+      return std::string_view::npos;
+
+    // paths ending here resolve to this value; the rest go one level down
+    std::vector<uint32_t> deeper;
+    for (auto const idx : active) {
+      if (paths[idx].tokens_.size() == depth) {
+        if (!found[idx].has_value()) {
+          found[idx] = value_at(text, pos);
+          if (!found[idx].has_value())
+            return std::string_view::npos;
+          --remaining;
+        }
+      } else {
+        deeper.push_back(idx);
+      }
+    }
+    if (remaining == 0)
+      return std::string_view::npos;
+    if (deeper.empty())
+      return internal::skip_value(text, pos);
+
+    std::vector<uint32_t> matched;
+    auto const descend = [&](size_t value) {
+      if (matched.empty())
+        return internal::kSkip;
+      return walk(paths, text, value, depth + 1, matched, found, remaining,
+                  scratch);
+    };
+
+    if (text[pos] == '{') {
+      return internal::for_each_member(
+          text, pos, scratch, [&](std::string_view key, size_t value) {
+            matched.clear();
+            for (auto const idx : deeper) {
+              if (!found[idx].has_value() &&
+                  paths[idx].tokens_[depth].key == key)
+                matched.push_back(idx);
+            }
+            return descend(value);
+          });
+    }
+    if (text[pos] == '[') {
+      size_t element = 0;
+      return internal::for_each_element(text, pos, [&](size_t value) {
+        matched.clear();
+        for (auto const idx : deeper) {
+          if (!found[idx].has_value() &&
+              paths[idx].tokens_[depth].index == element)
+            matched.push_back(idx);
+        }
+        ++element;
+        return descend(value);
+      });
+    }
+    return internal::skip_value(text, pos);
+  }
+
+  std::vector<Token> tokens_;
+};
+
+} // namespace XSON
@@ -0,0 +1,627 @@
+#pragma once
+
+/**
+ *  @brief  allocation-free JSON text scanning shared by the XSON backends
+ *          that work on the raw bytes: grammar validation, skipping whole
+ *          values, string unescaping/escaping and number conversion with
+ *          std::from_chars/std::to_chars.
+ */
+
+#ifndef _UNIHEADER_BUILD_
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <charconv>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <system_error>
+#endif
+
+namespace XSON::internal {
+
+/// JSON value kinds, as seen by the backends that classify raw text
+enum class KIND : uint8_t { NUL, BOOLEAN, NUMBER, STRING, ARRAY, OBJECT };
+
+/// where and why a scan stopped
+struct ScanError {
+  size_t offset = 0;
+  std::string_view what;
+};
+
+/// a JSON number: integers that fit int64_t are kept exact
+struct Number {
+  double real = 0;
+  int64_t integer = 0;
+  bool is_integer = false;
+
+  bool operator==(Number const &) const = default;
+};
+
+/// deepest container nesting validate() accepts
+inline constexpr size_t kMaxDepth = 1024;
+
+constexpr bool is_ws(char chr) noexcept {
+  return chr == ' ' || chr == '\n' || chr == '\r' || chr == '\t';
+}
+
+constexpr size_t skip_ws(std::string_view text, size_t pos) noexcept {
+  while (pos < text.size() && is_ws(text[pos]))
+    ++pos;
+  return pos;
+}
+
+/// kind of the (valid) value whose first character is @p first
+constexpr KIND kind_of(char first) noexcept {
+  switch (first) {
+  case '{':
+    return KIND::OBJECT;
+  case '[':
+    return KIND::ARRAY;
+  case '"':
+    return KIND::STRING;
+  case 't':
+  case 'f':
+    return KIND::BOOLEAN;
+  case 'n':
+    return KIND::NUL;
+  default:
+    return KIND::NUMBER;
+  }
+}
+
+/// one past the closing quote of the string opening at @p pos, or npos if
+/// unterminated. Sets @p escaped if the body contains backslash escapes.
+/// Quotes are found with memchr; a quote preceded by an odd run of
+/// backslashes is escaped and skipped.
+inline size_t skip_string(std::string_view text, size_t pos,
+                          bool *escaped = nullptr) noexcept {
+  auto const *const base = text.data();
+  auto const *const body = base + pos + 1;
+  auto const *const end = base + text.size();
+
+  for (auto const *cur = body; cur < end; ++cur) {
+    cur = static_cast<char const *>(
+        std::memchr(cur, '"', static_cast<size_t>(end - cur)));
+    if (cur == nullptr)
+      break;
+
+    auto const *run = cur;
+    while (run != body && run[-1] == '\\')
+      --run;
+    if ((cur - run) % 2 != 0)
+      continue;
+
+    if (escaped != nullptr && !*escaped)
+      *escaped = std::memchr(body, '\\', static_cast<size_t>(cur - body)) !=
+                 nullptr;
+    return static_cast<size_t>(cur - base) + 1;
+  }
+  return std::string_view::npos;
+}
+
+/// one past the end of the number token starting at @p pos, or npos if it
+/// does not follow the JSON number grammar
+inline size_t scan_number(std::string_view text, size_t pos) noexcept {
+  auto const digits = [&]() {
+    auto const start = pos;
+    while (pos < text.size() && text[pos] >= '0' && text[pos] <= '9')
+      ++pos;
+    return pos - start;
+  };
+
+  if (pos < text.size() && text[pos] == '-')
+    ++pos;
+  if (pos < text.size() && text[pos] == '0')
+    ++pos;
+  else if (digits() == 0)
+    return std::string_view::npos;
+
+  if (pos < text.size() && text[pos] == '.') {
+    ++pos;
+    if (digits() == 0)
+      return std::string_view::npos;
+  }
+
+  if (pos < text.size() && (text[pos] == 'e' || text[pos] == 'E')) {
+    ++pos;
+    if (pos < text.size() && (text[pos] == '+' || text[pos] == '-'))
+      ++pos;
+    if (digits() == 0)
+      return std::string_view::npos;
+  }
+
+  return pos;
+}
+
+/// bytes skip_value() has to stop at inside a container
+inline constexpr auto kStructural = []() {
+  std::array<bool, 256> table{};
+  for (auto chr : std::string_view{"\"{}[]"})
+    table[static_cast<unsigned char>(chr)] = true;
+  return table;
+}();
+
+/// end of the value starting at @p pos in text already known to be valid:
+/// strings and containers are skipped without looking inside them beyond
+/// quotes and brackets
+inline size_t skip_value(std::string_view text, size_t pos) noexcept {
+  switch (text[pos]) {
+  case '"':
+    return skip_string(text, pos);
+  case '{':
+  case '[': {
+    size_t depth = 0;
+    for (; pos < text.size(); ++pos) {
+      auto const chr = text[pos];
+      if (!kStructural[static_cast<unsigned char>(chr)])
+        continue;
+      if (chr == '"') {
+        pos = skip_string(text, pos) - 1;
+      } else if (chr == '{' || chr == '[') {
+        ++depth;
+      } else if (--depth == 0) {
+        return pos + 1;
+      }
+    }
+    return text.size();
+  }
+  default:
+    while (pos < text.size() && text[pos] != ',' && text[pos] != '}' &&
+           text[pos] != ']' && !is_ws(text[pos]))
+      ++pos;
+    return pos;
+  }
+}
+
+/// escapes in a string body are well-formed: \uXXXX has four hex digits,
+/// and a UTF-16 surrogate only appears as a high/low pair (a lone one has no
+/// UTF-8 encoding)
+inline bool valid_escapes(std::string_view body) noexcept {
+  auto const hex4 = [&](size_t pos) -> std::optional<uint32_t> {
+    uint32_t code = 0;
+    if (pos + 4 > body.size())
+      return std::nullopt;
+    if (auto const [ptr, ec] =
+            std::from_chars(body.data() + pos, body.data() + pos + 4, code, 16);
+        ec != std::errc{} || ptr != body.data() + pos + 4)
+      return std::nullopt;
+    return code;
+  };
+
+  for (auto pos = body.find('\\'); pos != std::string_view::npos;
+       pos = body.find('\\', pos)) {
+    if (pos + 1 >= body.size())
+      return false;
+    switch (body[pos + 1]) {
+    case '"':
+    case '\\':
+    case '/':
+    case 'b':
+    case 'f':
+    case 'n':
+    case 'r':
+    case 't':
+      pos += 2;
+      break;
+    case 'u': {
+      auto const code = hex4(pos + 2);
+      if (!code.has_value() || (*code >= 0xdc00 && *code < 0xe000))
+        return false;
+      pos += 6;
+      if (*code >= 0xd800 && *code < 0xdc00) {
+        if (pos + 1 >= body.size() || body[pos] != '\\' ||
+            body[pos + 1] != 'u')
+          return false;
+        auto const low = hex4(pos + 2);
+        if (!low.has_value() || *low < 0xdc00 || *low >= 0xe000)
+          return false;
+        pos += 6;
+      }
+      break;
+    }
+    default:
+      return false;
+    }
+  }
+  return true;
+}
+
+/// a string body as JSON allows it: no raw control characters (U+0000 to
+/// U+001F must be escaped) and, if skip_string() reported @p escaped ones,
+/// valid escapes
+inline bool valid_string(std::string_view body, bool escaped) noexcept {
+  if (std::ranges::any_of(body, [](char chr) {
+        return static_cast<unsigned char>(chr) < 0x20;
+      }))
+    return false;
+  return !escaped || valid_escapes(body);
+}
+
+/// check that @p text is exactly one JSON value (plus whitespace); the
+/// structural pass the lazy backends run once before indexing on demand
+inline std::optional<ScanError> validate(std::string_view text) {
+  std::string stack; // '{' or '[' per open container
+  size_t pos = 0;
+
+  auto const fail = [&](std::string_view what) {
+    return std::optional<ScanError>{ScanError{pos, what}};
+  };
+
+  // "key" : -- leaves pos at the member value
+  auto const read_key = [&]() -> std::optional<ScanError> {
+    pos = skip_ws(text, pos);
+    if (pos >= text.size() || text[pos] != '"')
+      return fail("expected object key");
+    auto escaped = false;
+    auto const end = skip_string(text, pos, &escaped);
+    if (end == std::string_view::npos)
+      return fail("unterminated string");
+    if (!valid_string(text.substr(pos + 1, end - pos - 2), escaped))
+      return fail("invalid string");
+    pos = skip_ws(text, end);
+    if (pos >= text.size() || text[pos] != ':')
+      return fail("expected ':'");
+    ++pos;
+    return std::nullopt;
+  };
+
+  auto need_value = true;
+
+  for (;;) {
+    if (need_value) {
+      pos = skip_ws(text, pos);
+      if (pos >= text.size())
+        return fail("unexpected end of input");
+
+      switch (auto const chr = text[pos]; chr) {
+      case '{':
+      case '[':
+        if (stack.size() == kMaxDepth)
+          return fail("nesting too deep");
+        stack.push_back(chr);
+        pos = skip_ws(text, pos + 1);
+        if (pos < text.size() && text[pos] == (chr == '{' ? '}' : ']')) {
+          stack.pop_back();
+          ++pos;
+          break;
+        }
+        if (chr == '{') {
+          if (auto err = read_key())
+            return err;
+        }
+        continue;
+      case '"': {
+        auto escaped = false;
+        auto const end = skip_string(text, pos, &escaped);
+        if (end == std::string_view::npos)
+          return fail("unterminated string");
+        if (!valid_string(text.substr(pos + 1, end - pos - 2), escaped))
+          return fail("invalid string");
+        pos = end;
+        break;
+      }
+      case 't':
+      case 'f':
+      case 'n': {
+        auto const literal = chr == 't'   ? std::string_view{"true"}
+                             : chr == 'f' ? std::string_view{"false"}
+                                          : std::string_view{"null"};
+        if (text.substr(pos, literal.size()) != literal)
+          return fail("invalid literal");
+        pos += literal.size();
+        break;
+      }
+      default: {
+        auto const end = scan_number(text, pos);
+        if (end == std::string_view::npos)
+          return fail("unexpected character");
+        pos = end;
+      }
+      }
+    }
+
+    // after a value
+    pos = skip_ws(text, pos);
+    if (stack.empty())
+      return pos == text.size() ? std::nullopt : fail("trailing characters");
+    if (pos >= text.size())
+      return fail("unexpected end of input");
+
+    if (text[pos] == ',') {
+      ++pos;
+      if (stack.back() == '{') {
+        if (auto err = read_key())
+          return err;
+      }
+      need_value = true;
+      continue;
+    }
+
+    if (text[pos] == (stack.back() == '{' ? '}' : ']')) {
+      stack.pop_back();
+      ++pos;
+      need_value = false;
+      continue;
+    }
+
+    return fail("expected ',' or closing bracket");
+  }
+}
+
+/// append the UTF-8 encoding of @p code to @p out
+inline void append_utf8(std::string &out, uint32_t code) {
+  if (code < 0x80) {
+    out += static_cast<char>(code);
+  } else if (code < 0x800) {
+    out += static_cast<char>(0xc0 | (code >> 6));
+    out += static_cast<char>(0x80 | (code & 0x3f));
+  } else if (code < 0x10000) {
+    out += static_cast<char>(0xe0 | (code >> 12));
+    out += static_cast<char>(0x80 | ((code >> 6) & 0x3f));
+    out += static_cast<char>(0x80 | (code & 0x3f));
+  } else {
+    out += static_cast<char>(0xf0 | (code >> 18));
+    out += static_cast<char>(0x80 | ((code >> 12) & 0x3f));
+    out += static_cast<char>(0x80 | ((code >> 6) & 0x3f));
+    out += static_cast<char>(0x80 | (code & 0x3f));
+  }
+}
+
+/// decode a (valid) string body, the text between the quotes, into @p out
+inline void unescape(std::string_view body, std::string &out) {
+  out.clear();
+  out.reserve(body.size());
+
+  auto const hex4 = [&](size_t pos) {
+    uint32_t code = 0;
+    std::from_chars(body.data() + pos, body.data() + pos + 4, code, 16);
+    return code;
+  };
+
+  size_t pos = 0;
+  for (auto esc = body.find('\\'); esc != std::string_view::npos;
+       esc = body.find('\\', pos)) {
+    out.append(body, pos, esc - pos);
+
+    switch (auto const chr = body[esc + 1]; chr) {
+    case 'b':
+      out += '\b';
+      break;
+    case 'f':
+      out += '\f';
+      break;
+    case 'n':
+      out += '\n';
+      break;
+    case 'r':
+      out += '\r';
+      break;
+    case 't':
+      out += '\t';
+      break;
+    case 'u': {
+      auto code = hex4(esc + 2);
+      pos = esc + 6;
+      // surrogate pair
+      if (code >= 0xd800 && code < 0xdc00 && pos + 6 <= body.size() &&
+          body[pos] == '\\' && body[pos + 1] == 'u') {
+        if (auto const low = hex4(pos + 2); low >= 0xdc00 && low < 0xe000) {
+          code = 0x10000 + ((code - 0xd800) << 10) + (low - 0xdc00);
+          pos += 6;
+        }
+      }
+      append_utf8(out, code);
+      continue;
+    }
+    default:
+      out += chr;
+    }
+    pos = esc + 2;
+  }
+
+  out.append(body, pos);
+}
+
+/// string value of the (valid) string token @p token, quotes included
+inline std::string unquote(std::string_view token) {
+  std::string out;
+  auto const body = token.substr(1, token.size() - 2);
+  if (body.find('\\') == std::string_view::npos)
+    out.assign(body);
+  else
+    unescape(body, out);
+  return out;
+}
+
+/// value of the (valid) number token @p token
+inline Number parse_number(std::string_view token) noexcept {
+  Number number;
+  auto const *const first = token.data();
+  auto const *const last = first + token.size();
+
+  if (token.find_first_of(".eE") == std::string_view::npos) {
+    if (auto const [ptr, ec] = std::from_chars(first, last, number.integer);
+        ec == std::errc{} && ptr == last) {
+      number.is_integer = true;
+      number.real = static_cast<double>(number.integer);
+      return number;
+    }
+  }
+
+  if (auto const [ptr, ec] = std::from_chars(first, last, number.real);
+      ec == std::errc::result_out_of_range) {
+    number.real = token.front() == '-' ? -HUGE_VAL : HUGE_VAL;
+  }
+  return number;
+}
+
+/// append @p text to @p out as a quoted JSON string
+inline void escape(std::string &out, std::string_view text) {
+  static constexpr std::string_view kHex = "0123456789abcdef";
+
+  out += '"';
+  size_t run = 0;
+  for (size_t pos = 0; pos < text.size(); ++pos) {
+    auto const chr = static_cast<unsigned char>(text[pos]);
+    if (chr >= 0x20 && chr != '"' && chr != '\\')
+      continue;
+
+    out.append(text, run, pos - run);
+    run = pos + 1;
+    switch (chr) {
+    case '"':
+      out += R"(\")";
+      break;
+    case '\\':
+      out += R"(\\)";
+      break;
+    case '\b':
+      out += R"(\b)";
+      break;
+    case '\f':
+      out += R"(\f)";
+      break;
+    case '\n':
+      out += R"(\n)";
+      break;
+    case '\r':
+      out += R"(\r)";
+      break;
+    case '\t':
+      out += R"(\t)";
+      break;
+    default:
+      out += R"(\u00)";
+      out += kHex[chr >> 4];
+      out += kHex[chr & 0x0f];
+    }
+  }
+  out.append(text, run);
+  out += '"';
+}
+
+/// append @p number to @p out; non-integral doubles keep a fraction or
+/// exponent so they read back as doubles, non-finite ones become null
+inline void write_number(std::string &out, Number const &number) {
+  std::array<char, 32> digits{};
+  auto *const first = digits.data();
+  auto *const last = first + digits.size();
+
+  if (number.is_integer) {
+    out.append(first, std::to_chars(first, last, number.integer).ptr);
+    return;
+  }
+
+  if (!std::isfinite(number.real)) {
+    out += "null";
+    return;
+  }
+
+  auto const *const end = std::to_chars(first, last, number.real).ptr;
+  auto const written =
+      std::string_view{first, static_cast<size_t>(end - first)};
+  out += written;
+  if (written.find_first_of(".e") == std::string_view::npos)
+    out += ".0";
+}
+
+/// append the (valid) JSON text @p raw without insignificant whitespace
+inline void minify(std::string &out, std::string_view raw) {
+  size_t pos = 0;
+  while (pos < raw.size()) {
+    auto const next = raw.find_first_of("\" \n\r\t", pos);
+    if (next == std::string_view::npos) {
+      out.append(raw, pos);
+      return;
+    }
+    out.append(raw, pos, next - pos);
+    if (raw[next] == '"') {
+      auto const end = skip_string(raw, next);
+      out.append(raw, next, end - next);
+      pos = end;
+    } else {
+      pos = skip_ws(raw, next);
+    }
+  }
+}
+
+/// what a for_each_member() / for_each_element() visitor returns when it
+/// did not walk the value itself, or to end the walk; any other result is
+/// the end of the value it walked
+inline constexpr size_t kSkip = 0;
+inline constexpr size_t kStop = std::string_view::npos;
+
+/// @p visit(key, value offset) for each member of the object opening at
+/// @p pos until it returns kStop; the end of the object, or npos if the
+/// walk stopped early or hit malformed text. Escaped keys are decoded into
+/// @p scratch, plain ones are compared in place.
+template <typename F>
+size_t for_each_member(std::string_view text, size_t pos, std::string &scratch,
+                       F &&visit) {
+  pos = skip_ws(text, pos + 1);
+  if (pos < text.size() && text[pos] == '}')
+    return pos + 1;
+
+  while (pos < text.size() && text[pos] == '"') {
+    bool escaped = false;
+    auto const key_end = skip_string(text, pos, &escaped);
+    if (key_end == std::string_view::npos)
+      return std::string_view::npos;
+    auto key = text.substr(pos + 1, key_end - pos - 2);
+    if (escaped) {
+      scratch.clear();
+      unescape(key, scratch);
+      key = scratch;
+    }
+
+    pos = skip_ws(text, key_end);
+    if (pos >= text.size() || text[pos] != ':')
+      return std::string_view::npos;
+    pos = skip_ws(text, pos + 1);
+    if (pos >= text.size())
+      return std::string_view::npos;
+
+    auto end = visit(key, pos);
+    if (end == kSkip)
+      end = skip_value(text, pos);
+    if (end == std::string_view::npos || end == pos)
+      return std::string_view::npos;
+    pos = skip_ws(text, end);
+    if (pos < text.size() && text[pos] == '}')
+      return pos + 1;
+    if (pos >= text.size() || text[pos] != ',')
+      return std::string_view::npos;
+    pos = skip_ws(text, pos + 1);
+  }
+  return std::string_view::npos;
+}
+
+/// for_each_member() for the elements of the array opening at @p pos
+template <typename F>
+size_t for_each_element(std::string_view text, size_t pos, F &&visit) {
+  pos = skip_ws(text, pos + 1);
+  if (pos < text.size() && text[pos] == ']')
+    return pos + 1;
+
+  while (pos < text.size()) {
+    auto end = visit(pos);
+    if (end == kSkip)
+      end = skip_value(text, pos);
+    if (end == std::string_view::npos || end == pos)
+      return std::string_view::npos;
+    pos = skip_ws(text, end);
+    if (pos < text.size() && text[pos] == ']')
+      return pos + 1;
+    if (pos >= text.size() || text[pos] != ',')
+      return std::string_view::npos;
+    pos = skip_ws(text, pos + 1);
+  }
+  return std::string_view::npos;
+}
+
+} // namespace XSON::internal
@@ -0,0 +1,164 @@
+#pragma once
+
+/**
+ *  @brief  XSON::SIMD, the Lazy front end over a simdjson DOM: simdjson's
+ *          SIMD structural indexing builds the document tape in one pass,
+ *          and values are materialized from the tape as they are touched.
+ */
+
+#ifndef _UNIHEADER_BUILD_
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include <simdjson.h>
+#endif
+
+#include <falutez/falutez-serio-lazy.hpp>
+#include <falutez/falutez-serio-scan.hpp>
+
+namespace XSON {
+
+namespace internal {
+
+/**
+ * @brief a simdjson DOM as the source of a Lazy document. Handles are tape
+ *        positions inside the dom::document the holder keeps alive.
+ */
+struct SimdSource {
+  using handle = simdjson::dom::element;
+
+  struct Document {
+    std::shared_ptr<void const> holder;
+    handle root;
+  };
+
+  static FLZ::expected<Document, ScanError> parse(std::string_view text) {
+    // the parser's structural index is reused across parses on a thread; the
+    // tape and string buffer belong to each document
+    static thread_local simdjson::dom::parser parser;
+
+    auto document = std::make_shared<simdjson::dom::document>();
+    handle root;
+    if (auto const error =
+            parser.parse_into_document(*document, text.data(), text.size())
+                .get(root))
+      return FLZ::unexpected(ScanError{0, simdjson::error_message(error)});
+    return Document{std::move(document), root};
+  }
+
+  static KIND kind(handle value) {
+    switch (value.type()) {
+    case simdjson::dom::element_type::NULL_VALUE:
+      return KIND::NUL;
+    case simdjson::dom::element_type::BOOL:
+      return KIND::BOOLEAN;
+    case simdjson::dom::element_type::STRING:
+      return KIND::STRING;
+    case simdjson::dom::element_type::ARRAY:
+      return KIND::ARRAY;
+    case simdjson::dom::element_type::OBJECT:
+      return KIND::OBJECT;
+    default:
+      return KIND::NUMBER;
+    }
+  }
+
+  static bool boolean(handle value) { return value.get_bool().value_unsafe(); }
+
+  static Number number(handle value) {
+    switch (value.type()) {
+    case simdjson::dom::element_type::INT64: {
+      auto const integer = value.get_int64().value_unsafe();
+      return Number{.real = static_cast<double>(integer),
+                    .integer = integer,
+                    .is_integer = true};
+    }
+    case simdjson::dom::element_type::UINT64: {
+      auto const integer = value.get_uint64().value_unsafe();
+      if (integer > static_cast<uint64_t>(INT64_MAX))
+        return Number{.real = static_cast<double>(integer)};
+      return Number{.real = static_cast<double>(integer),
+                    .integer = static_cast<int64_t>(integer),
+                    .is_integer = true};
+    }
+    default:
+      return Number{.real = value.get_double().value_unsafe()};
+    }
+  }
+
+  static std::string string(handle value) {
+    return std::string{value.get_string().value_unsafe()};
+  }
+
+  /// @p visit(handle) for each element of the array @p value
+  template <typename F> static void elements(handle value, F &&visit) {
+    // held by value: ranging over value_unsafe() of the temporary result
+    // would dangle
+    auto const array = value.get_array().value_unsafe();
+    for (auto const elm : array)
+      visit(elm);
+  }
+
+  /// @p visit(std::string key, handle) for each member of the object @p value
+  template <typename F> static void members(handle value, F &&visit) {
+    auto const object = value.get_object().value_unsafe();
+    for (auto const [key, member] : object)
+      visit(std::string{key}, member);
+  }
+
+  /// the same encoding a materialized Lazy value writes
+  static void write(handle value, std::string &out) {
+    switch (kind(value)) {
+    case KIND::NUL:
+      out += "null";
+      break;
+    case KIND::BOOLEAN:
+      out += boolean(value) ? "true" : "false";
+      break;
+    case KIND::NUMBER:
+      write_number(out, number(value));
+      break;
+    case KIND::STRING:
+      escape(out, value.get_string().value_unsafe());
+      break;
+    case KIND::ARRAY: {
+      out += '[';
+      auto first = true;
+      auto const array = value.get_array().value_unsafe();
+      for (auto const elm : array) {
+        if (!std::exchange(first, false))
+          out += ',';
+        write(elm, out);
+      }
+      out += ']';
+      break;
+    }
+    case KIND::OBJECT: {
+      out += '{';
+      auto first = true;
+      auto const object = value.get_object().value_unsafe();
+      for (auto const [key, member] : object) {
+        if (!std::exchange(first, false))
+          out += ',';
+        escape(out, key);
+        out += ':';
+        write(member, out);
+      }
+      out += '}';
+      break;
+    }
+    }
+  }
+};
+
+} // namespace internal
+
+/// simdjson-parsed JSON, materialized as it is accessed
+using SIMD = internal::Lazy<internal::SimdSource>;
+
+static_assert(XSON<SIMD>);
+
+} // namespace XSON
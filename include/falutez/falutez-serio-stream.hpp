@@ -0,0 +1,251 @@
+#pragma once
+
+/**
+ *  @brief  incremental reading of documents that are one huge top-level JSON
+ *          array: input is fed in chunks and each element is handed back as
+ *          soon as its last byte arrives, so memory is bounded by the largest
+ *          element rather than by the document.
+ */
+
+#ifndef _UNIHEADER_BUILD_
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#endif
+
+#include <falutez/falutez-serio-scan.hpp>
+#include <falutez/falutez-serio.hpp>
+
+namespace XSON {
+
+namespace internal {
+
+/// @p text parsed as an XSON value, or decoded straight into a
+/// glaze-reflectable struct (see XSON::decode); throws on malformed input
+template <typename T> T parse_as(std::string_view text) {
+  if constexpr (XSON<T>) {
+    return T::parse(text);
+  } else {
+    auto decoded = decode<T>(text);
+    if (!decoded.has_value())
+      throw decoded.error();
+    return std::move(*decoded);
+  }
+}
+
+} // namespace internal
+
+/**
+ * @brief pull parser over a top-level JSON array fed in chunks.
+ *
+ *   XSON::ArrayStream stream;
+ *   while (auto chunk = read_some()) {
+ *     stream.feed(*chunk);
+ *     while (auto order = stream.next<XSON::JSON>())
+ *       handle(*order);
+ *   }
+ *   stream.finish(); // throws if the array was cut short
+ *
+ * The array's own structure is checked here; each element is validated by
+ * whatever parses it. Views returned by next() stay valid until the next
+ * feed().
+ */
+class ArrayStream {
+public:
+  /// elements larger than @p max_element bytes are rejected
+  explicit ArrayStream(size_t max_element = size_t{64} << 20)
+      : max_element_{max_element} {}
+
+  /// append the next chunk of input
+  void feed(std::string_view chunk) {
+    if (finished_)
+      throw std::runtime_error{std::format("{}:{}:{}: feed() after finish()",
+                                           __FILE__, __LINE__, __func__)};
+    // drop what has been handed out; whatever is left is the element in
+    // progress, so the buffer never holds much more than one element
+    buffer_.erase(0, pos_);
+    consumed_ += pos_;
+    scan_ -= std::min(scan_, pos_);
+    pos_ = 0;
+    buffer_.append(chunk);
+  }
+
+  /// visitor form: feed @p chunk and pass each completed element's text to
+  /// @p visit
+  template <typename F> void feed(std::string_view chunk, F &&visit) {
+    feed(chunk);
+    while (auto const text = next())
+      visit(*text);
+  }
+
+  /// no more input; throws unless the array was closed
+  void finish() {
+    finished_ = true;
+    if (next().has_value())
+      throw std::runtime_error{
+          std::format("{}:{}:{}: unread elements remain", __FILE__, __LINE__,
+                      __func__)};
+  }
+
+  [[nodiscard]] bool done() const noexcept { return state_ == State::DONE; }
+
+  /// the next complete element's text, or nullopt until more input arrives
+  std::optional<std::string_view> next() {
+    std::string_view const text = buffer_;
+
+    for (;;) {
+      pos_ = internal::skip_ws(text, pos_);
+      if (pos_ >= text.size() && state_ != State::ELEMENT) {
+        if (finished_ && state_ != State::DONE)
+          fail("truncated input");
+        return std::nullopt;
+      }
+
+      switch (state_) {
+      case State::START:
+        if (text[pos_] != '[')
+          fail("expected a top-level array");
+        ++pos_;
+        state_ = State::FIRST;
+        break;
+      case State::FIRST:
+      case State::NEXT:
+        if (text[pos_] == ']' && state_ == State::FIRST) {
+          ++pos_;
+          state_ = State::DONE;
+          break;
+        }
+        state_ = State::ELEMENT;
+        scan_ = pos_;
+        depth_ = 0;
+        in_string_ = false;
+        break;
+      case State::ELEMENT: {
+        auto const end = scan(text);
+        if (!end.has_value()) {
+          if (finished_)
+            fail("truncated input");
+          if (text.size() - pos_ > max_element_)
+            fail("element too large");
+          return std::nullopt;
+        }
+        if (*end == pos_)
+          fail("expected a value");
+        if (*end - pos_ > max_element_)
+          fail("element too large");
+        auto const element = text.substr(pos_, *end - pos_);
+        pos_ = *end;
+        state_ = State::AFTER;
+        return element;
+      }
+      case State::AFTER:
+        if (text[pos_] == ',') {
+          state_ = State::NEXT;
+        } else if (text[pos_] == ']') {
+          state_ = State::DONE;
+        } else {
+          fail("expected ',' or ']'");
+        }
+        ++pos_;
+        break;
+      case State::DONE:
+        fail("trailing characters");
+      }
+    }
+  }
+
+  /// the next element as an XSON value or a reflectable struct
+  template <typename T> std::optional<T> next() {
+    auto const text = next();
+    if (!text.has_value())
+      return std::nullopt;
+    return internal::parse_as<T>(*text);
+  }
+
+private:
+  enum class State : uint8_t { START, FIRST, ELEMENT, AFTER, NEXT, DONE };
+
+  [[noreturn]] void fail(std::string_view what) const {
+    throw std::runtime_error{std::format("{}:{}:{}: {} at offset {}", __FILE__,
+                                         __LINE__, __func__, what,
+                                         consumed_ + pos_)};
+  }
+
+  /// resume scanning the element that starts at pos_; its end offset once
+  /// the last byte is in the buffer. A scalar ends at the delimiter after
+  /// it, so it is complete only once that delimiter has arrived too.
+  std::optional<size_t> scan(std::string_view text) {
+    auto pos = scan_;
+    while (pos < text.size()) {
+      if (in_string_) {
+        auto const quote = text.find('"', pos);
+        if (quote == std::string_view::npos) {
+          pos = text.size();
+          break;
+        }
+        // an odd run of backslashes escapes the quote
+        size_t run = 0;
+        while (text[quote - 1 - run] == '\\')
+          ++run;
+        pos = quote + 1;
+        if (run % 2 == 1)
+          continue;
+        in_string_ = false;
+        if (depth_ == 0)
+          return pos;
+        continue;
+      }
+
+      switch (text[pos]) {
+      case '"':
+        in_string_ = true;
+        break;
+      case '{':
+      case '[':
+        ++depth_;
+        break;
+      case '}':
+      case ']':
+        if (depth_ == 0)
+          return pos;
+        if (--depth_ == 0)
+          return pos + 1;
+        break;
+      case ',':
+      case ' ':
+      case '\t':
+      case '\n':
+      case '\r':
+        if (depth_ == 0)
+          return pos;
+        break;
+      default:
+        break;
+      }
+      ++pos;
+    }
+    scan_ = pos;
+    return std::nullopt;
+  }
+
+  std::string buffer_;
+  /// first unconsumed byte of buffer_
+  size_t pos_ = 0;
+  /// where scan() resumes inside the element in progress
+  size_t scan_ = 0;
+  /// bytes dropped from the front of buffer_, for error offsets
+  size_t consumed_ = 0;
+  size_t max_element_;
+  size_t depth_ = 0;
+  bool in_string_ = false;
+  bool finished_ = false;
+  State state_ = State::START;
+};
+
+} // namespace XSON
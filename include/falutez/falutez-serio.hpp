@@ -1,12 +1,18 @@
 #pragma once
 
 #ifndef _UNIHEADER_BUILD_
+#include <charconv>
+#include <cmath>
 #include <concepts>
 #include <format>
 #include <limits>
+#include <map>
+#include <stdexcept>
 #include <string>
 #include <string_view>
+#include <system_error>
 #include <type_traits>
+#include <utility>
 #include <variant>
 
 #include <glaze/core/context.hpp>
@@ -20,11 +26,38 @@
 #include <nlohmann/json_fwd.hpp>
 #endif
 
+#include <falutez/falutez-serio-scan.hpp>
 #include <falutez/falutez-types-std.hpp>
 
 namespace XSON {
 
 namespace internal {
+/// the whole of @p str as a number; std::from_chars, so no locale, no
+/// allocation and no exceptions
+template <typename T>
+static inline FLZ::expected<T, std::runtime_error>
+number_from_chars(std::string_view str) {
+  T value{};
+  auto const *const end = str.data() + str.size();
+  auto const [ptr, ec] = std::from_chars(str.data(), end, value);
+  if (ec == std::errc::result_out_of_range)
+    return FLZ::unexpected(
+        std::range_error{"string is out of range for the requested type"});
+  if (ec != std::errc{} || ptr != end)
+    return FLZ::unexpected(
+        std::runtime_error{"string is not a number of the requested type"});
+  return value;
+}
+
+/// @p idx as the position a writing operator[] pads up to; a negative one
+/// is refused rather than wrapped into an enormous padding
+template <std::integral I> static inline size_t element_index(I idx) {
+  if (std::cmp_less(idx, 0))
+    throw std::out_of_range{std::format("{}:{}:{}: negative index {}",
+                                        __FILE__, __LINE__, __func__, idx)};
+  return static_cast<size_t>(idx);
+}
+
 template <typename NLH, typename T>
 static inline FLZ::expected<T, std::runtime_error>
 coerce_impl(NLH const &self) {
@@ -59,11 +92,7 @@ coerce_impl(NLH const &self) {
         return FLZ::unexpected(std::range_error{
             std::format("empty string may be coerced to integral type")});
 
-      if constexpr (std::is_signed_v<T>) {
-        return std::stoll(str);
-      } else {
-        return std::stoull(str);
-      }
+      return number_from_chars<T>(str);
     }
 
     if (self.is_boolean())
@@ -83,7 +112,7 @@ coerce_impl(NLH const &self) {
         return FLZ::unexpected(std::range_error{
             std::format("empty string may be coerced to floating point type")});
 
-      return std::stod(str);
+      return number_from_chars<T>(str);
     }
 
     if (self.is_boolean())
@@ -117,6 +146,78 @@ coerce_impl(NLH const &self) {
       std::format("{}:{}:{}: coersion for requested type not supported",
                   __FILE__, __LINE__, __PRETTY_FUNCTION__)});
 }
+
+/// the number @p self as the integral T if it is a whole number T can
+/// hold, an error otherwise. Integers the backend keeps as such are checked
+/// exactly; the rest go through the double.
+template <typename XSONImpl, typename T>
+static inline FLZ::expected<T, std::runtime_error>
+integral_of(XSONImpl const &self) {
+  auto const out_of_range = [] {
+    return FLZ::unexpected(std::runtime_error{std::format(
+        "{}:{}:{}: out of range", __FILE__, __LINE__, __func__)});
+  };
+
+  if constexpr (requires { self.is_number_integer(); }) {
+    if (self.is_number_integer()) {
+      if constexpr (requires { self.is_number_unsigned(); }) {
+        if (self.is_number_unsigned()) {
+          auto const value = self.template get<uint64_t>();
+          if (!std::in_range<T>(value))
+            return out_of_range();
+          return static_cast<T>(value);
+        }
+      }
+      auto const value = self.template get<int64_t>();
+      if (!std::in_range<T>(value))
+        return out_of_range();
+      return static_cast<T>(value);
+    }
+  }
+
+  auto const value = self.template get<double>();
+  if (!std::isfinite(value) || std::trunc(value) != value)
+    return FLZ::unexpected(std::runtime_error{std::format(
+        "{}:{}:{}: not an integer", __FILE__, __LINE__, __func__)});
+  // [-2^digits, 2^digits) for signed T, [0, 2^digits) for unsigned: both
+  // bounds are exact as doubles, unlike max() itself
+  auto const limit = std::ldexp(1.0, std::numeric_limits<T>::digits);
+  if (value >= limit || value < (std::is_signed_v<T> ? -limit : 0.0))
+    return out_of_range();
+  return static_cast<T>(value);
+}
+
+/// get<T>() if @p self holds a T, an error otherwise; unlike coerce<T>()
+/// nothing is converted between kinds, and integral types only take whole
+/// numbers they can hold
+template <typename XSONImpl, typename T>
+static inline FLZ::expected<T, std::runtime_error>
+try_get_impl(XSONImpl const &self) {
+  static_assert(std::is_arithmetic_v<T> || std::is_same_v<T, std::string>,
+                "try_get<>() supports bool, numbers and std::string");
+
+  if constexpr (std::is_same_v<T, bool>) {
+    if (self.is_boolean())
+      return self.template get<bool>();
+    return FLZ::unexpected(std::runtime_error{
+        std::format("{}:{}:{}: not a boolean", __FILE__, __LINE__, __func__)});
+  } else if constexpr (std::is_integral_v<T>) {
+    if (self.is_number())
+      return integral_of<XSONImpl, T>(self);
+    return FLZ::unexpected(std::runtime_error{
+        std::format("{}:{}:{}: not a number", __FILE__, __LINE__, __func__)});
+  } else if constexpr (std::is_arithmetic_v<T>) {
+    if (self.is_number())
+      return self.template get<T>();
+    return FLZ::unexpected(std::runtime_error{
+        std::format("{}:{}:{}: not a number", __FILE__, __LINE__, __func__)});
+  } else {
+    if (self.is_string())
+      return T{self.get_string()};
+    return FLZ::unexpected(std::runtime_error{
+        std::format("{}:{}:{}: not a string", __FILE__, __LINE__, __func__)});
+  }
+}
 } // namespace internal
 
 template <typename R>
@@ -131,6 +232,23 @@ template <typename R> struct is_aggregate_container : std::false_type {};
 template <aggregate_container R>
 struct is_aggregate_container<R> : std::true_type {};
 
+/// maps and other key -> value containers whose keys can name JSON members
+template <typename M>
+concept keyed_container =
+    std::ranges::range<M> && requires {
+      typename std::remove_cvref_t<M>::key_type;
+      typename std::remove_cvref_t<M>::mapped_type;
+    } && std::convertible_to<typename std::remove_cvref_t<M>::key_type const &,
+                             std::string_view>;
+
+/**
+ * @brief what every backend offers. Where they could differ they follow
+ *        NLH: a writing operator[] turns null into an object or array, a
+ *        new key appends a null member and an index past the end pads the
+ *        array with nulls; a key an object repeats resolves to its last
+ *        occurrence. Backends that keep every parsed member (LAZY, ARENA,
+ *        SIMD) still list and serialize the repeats.
+ */
 template <typename TXSONImpl>
 concept XSON = requires(TXSONImpl obj) {
   /// @brief needs a serialize method to return a owned string
@@ -237,6 +355,23 @@ concept XSON = requires(TXSONImpl obj) {
 
   TXSONImpl::parse(std::string_view{});
 
+  /// @brief non-throwing counterparts of parse(), at() and get<>(): malformed
+  /// input, missing members and kind mismatches are values, not exceptions
+  {
+    TXSONImpl::try_parse(std::string_view{})
+  } -> std::same_as<FLZ::expected<TXSONImpl, std::runtime_error>>;
+
+  /// @brief the member, or nullptr if there is none or obj is not an object
+  { obj.find(std::string_view{}) } -> std::convertible_to<TXSONImpl const *>;
+
+  {
+    obj.template try_get<int64_t>()
+  } -> std::same_as<FLZ::expected<int64_t, std::runtime_error>>;
+
+  {
+    obj.template try_get<std::string>()
+  } -> std::same_as<FLZ::expected<std::string, std::runtime_error>>;
+
   typename TXSONImpl::object_t;
   typename TXSONImpl::array_t;
 };
@@ -336,20 +471,53 @@ struct NLH : public nlohmann::json {
     return the_obj;
   }
 
+  /// parse() that returns malformed input as an error instead of throwing
+  static FLZ::expected<NLH, std::runtime_error>
+  try_parse(std::string_view str) {
+    auto json = nlohmann::json::parse(str, nullptr, false);
+    if (!json.is_discarded())
+      return NLH{std::move(json)};
+
+    // without exceptions nlohmann does not say where it stopped; the
+    // scanner finds the offset, off the success path
+    auto const error = internal::validate(str);
+    return FLZ::unexpected(std::runtime_error{std::format(
+        "{}:{}:{}: {} at offset {}", __FILE__, __LINE__, __func__,
+        error.has_value() ? error->what : "malformed JSON",
+        error.has_value() ? error->offset : size_t{0})});
+  }
+
+  /// the member @p key, or nullptr if there is none or this is not an
+  /// object: at() in one lookup and without the exception. Hides
+  /// nlohmann::json::find(), which returns an iterator.
+  [[nodiscard]] NLH *find(std::string_view key) {
+    return const_cast<NLH *>(std::as_const(*this).find(key));
+  }
+
+  [[nodiscard]] NLH const *find(std::string_view key) const {
+    auto const member = nlohmann::json::find(key);
+    return member == this->end() ? nullptr
+                                 : static_cast<NLH const *>(&*member);
+  }
+
   [[nodiscard]] bool has_boolean_field(std::string_view key) const {
-    return this->contains(key) && this->at(key).is_boolean();
+    auto const *member = find(key);
+    return member != nullptr && member->is_boolean();
   }
 
   [[nodiscard]] bool has_double_field(std::string_view key) const {
-    return this->contains(key) && this->at(key).is_number_float();
+    auto const *member = find(key);
+    return member != nullptr && member->is_number_float();
   }
 
   [[nodiscard]] bool has_number_field(std::string_view key) const {
-    return this->contains(key) && this->at(key).is_number();
+    auto const *member = find(key);
+    return member != nullptr && member->is_number();
   }
 
   [[nodiscard]] bool has_string_field(std::string_view key) const {
-    return this->contains(key) && this->at(key).is_string();
+    auto const *member = find(key);
+    return member != nullptr && member->is_string();
   }
 
   [[nodiscard]] std::string &get_string() {
@@ -381,6 +549,10 @@ struct NLH : public nlohmann::json {
     return internal::coerce_impl<NLH, T>(*this);
   }
 
+  template <typename T> [[nodiscard]] auto try_get() const {
+    return internal::try_get_impl<NLH, T>(*this);
+  }
+
   NLH &operator[](const char *key) {
     return static_cast<NLH &>(nlohmann::json::operator[](key));
   }
@@ -596,18 +768,27 @@ struct GLZ : public glz::json_t {
   }
 
   GLZ &deserialize(std::string_view str) {
-    if (auto errc = glz::read_json<glz::json_t>(str); errc.has_value()) {
-      *(static_cast<glz::json_t *>(this)) = errc.value();
-    } else {
-      throw std::runtime_error{std::format(
-          "{}:{}:{}: {} at position {}; dump: {}; source: {}", __FILE__,
-          __LINE__, __func__, glz::format_error(errc), errc.error().location,
-          dump().value_or("<DUMP-UNAVAILABLE>"), str)};
-    }
+    auto parsed = try_parse(str);
+    if (!parsed.has_value())
+      throw std::move(parsed.error());
 
+    *(static_cast<glz::json_t *>(this)) = std::move(*parsed);
     return *this;
   }
 
+  /// parse() that returns malformed input as an error instead of throwing.
+  /// The message names the error and its offset only: neither the source
+  /// nor the document is copied into it.
+  static FLZ::expected<GLZ, std::runtime_error>
+  try_parse(std::string_view str) {
+    auto errc = glz::read_json<glz::json_t>(str);
+    if (!errc.has_value())
+      return FLZ::unexpected(std::runtime_error{std::format(
+          "{}:{}:{}: {} at position {}", __FILE__, __LINE__, __func__,
+          glz::format_error(errc), errc.error().location)});
+    return GLZ(std::move(errc.value()));
+  }
+
   [[nodiscard]] std::string serialize(bool _pretty = false) const {
     return glz::write_json(*this).value();
   }
@@ -676,6 +857,10 @@ struct GLZ : public glz::json_t {
     return internal::coerce_impl<GLZ, T>(*this);
   }
 
+  template <typename T> [[nodiscard]] auto try_get() const {
+    return internal::try_get_impl<GLZ, T>(*this);
+  }
+
   template <typename S>
     requires(std::convertible_to<S, std::string_view> && !std::integral<S>)
   GLZ &operator[](S &&key) {
@@ -691,17 +876,15 @@ struct GLZ : public glz::json_t {
 
     using object_t = std::map<std::string, GLZ, std::less<>>;
     auto &self_obj = *reinterpret_cast<object_t *>(this);
-    return self_obj[std::string{key}];
+    std::string_view const name{key};
+    if (auto member = self_obj.find(name); member != self_obj.end())
+      return member->second;
+    return self_obj.try_emplace(std::string{name}).first->second;
   }
   template <typename S>
     requires(std::convertible_to<S, std::string_view> && !std::integral<S>)
   GLZ const &operator[](S &&key) const {
-    using object_t = std::map<std::string, GLZ, std::less<>>;
-    if (!is_object())
-      throw std::runtime_error{
-          std::format("{}:{}:{}: not an object", __FILE__, __LINE__, __func__)};
-    auto const &self_obj = *reinterpret_cast<object_t const *>(this);
-    return self_obj.at(std::string{key});
+    return at(std::string_view{key});
   }
 
   GLZ const &operator[](std::integral auto idx) const {
@@ -713,6 +896,7 @@ struct GLZ : public glz::json_t {
     return self_arr.at(idx);
   }
 
+  /// as in NLH, an index past the end pads the array with nulls up to it
   GLZ &operator[](std::integral auto idx) {
     if (is_null()) {
       *static_cast<json_t *>(this) = array_t{};
@@ -722,25 +906,24 @@ struct GLZ : public glz::json_t {
           std::format("{}:{}:{}: not an array", __FILE__, __LINE__, __func__)};
     using array_t = std::vector<GLZ>;
     auto &self_arr = *reinterpret_cast<array_t *>(this);
-    return self_arr.at(idx);
+    auto const pos = internal::element_index(idx);
+    if (self_arr.size() <= pos)
+      self_arr.resize(pos + 1);
+    return self_arr[pos];
   }
 
   GLZ &at(std::string_view key) {
-    using object_t = std::map<std::string, GLZ, std::less<>>;
-    if (!is_object())
-      throw std::runtime_error{
-          std::format("{}:{}:{}: not an object", __FILE__, __LINE__, __func__)};
-    auto &self_obj = *reinterpret_cast<object_t *>(this);
-    return self_obj.at(std::string{key});
+    return const_cast<GLZ &>(std::as_const(*this).at(key));
   }
 
   [[nodiscard]] GLZ const &at(std::string_view key) const {
-    using object_t = std::map<std::string, GLZ, std::less<>>;
     if (!is_object())
       throw std::runtime_error{
           std::format("{}:{}:{}: not an object", __FILE__, __LINE__, __func__)};
-    auto const &self_obj = *reinterpret_cast<object_t const *>(this);
-    return self_obj.at(std::string{key});
+    if (auto const *member = find_member(key))
+      return *member;
+    throw std::out_of_range{std::format("{}:{}:{}: no member '{}'", __FILE__,
+                                        __LINE__, __func__, key)};
   }
 
   GLZ &at(std::integral auto idx) {
@@ -887,26 +1070,36 @@ struct GLZ : public glz::json_t {
     return false;
   }
 
-  [[nodiscard]] bool has_boolean_field(std::string_view key) const {
-    return this->contains(key) && this->at(key).is_boolean();
+  /// the member @p key, or nullptr if there is none or this is not an
+  /// object: at() in one lookup and without the exception
+  [[nodiscard]] GLZ *find(std::string_view key) {
+    return const_cast<GLZ *>(find_member(key));
   }
 
-  [[nodiscard]] bool has_double_field(std::string_view key) const {
-    if (!this->contains(key))
-      return false;
+  [[nodiscard]] GLZ const *find(std::string_view key) const {
+    return find_member(key);
+  }
 
-    auto const &val = this->at(key);
+  [[nodiscard]] bool has_boolean_field(std::string_view key) const {
+    auto const *member = find_member(key);
+    return member != nullptr && member->is_boolean();
+  }
 
-    return val.is_number() && std::fabs(std::fmod(val.get<double>(), 1.0)) >
-                                  std::numeric_limits<double>::epsilon();
+  [[nodiscard]] bool has_double_field(std::string_view key) const {
+    auto const *member = find_member(key);
+    return member != nullptr && member->is_number() &&
+           std::fabs(std::fmod(member->get<double>(), 1.0)) >
+               std::numeric_limits<double>::epsilon();
   }
 
   [[nodiscard]] bool has_number_field(std::string_view key) const {
-    return this->contains(key) && this->at(key).is_number();
+    auto const *member = find_member(key);
+    return member != nullptr && member->is_number();
   }
 
   [[nodiscard]] bool has_string_field(std::string_view key) const {
-    return this->contains(key) && this->at(key).is_string();
+    auto const *member = find_member(key);
+    return member != nullptr && member->is_string();
   }
 
   /// @TODO: re-enable once upstream deals with issue/PR
@@ -956,6 +1149,15 @@ private:
 
   template <typename U> friend class glz::meta;
 
+  /// heterogeneous lookup: no std::string is built for @p key
+  [[nodiscard]] GLZ const *find_member(std::string_view key) const {
+    if (!is_object())
+      return nullptr;
+    auto const &self_obj = get_object();
+    auto const member = self_obj.find(key);
+    return member == self_obj.end() ? nullptr : &member->second;
+  }
+
 public:
   std::vector<GLZ> &get_array() {
     using array_t = std::vector<GLZ>;
@@ -1009,6 +1211,32 @@ static_assert(sizeof(GLZ) == sizeof(glz::json_t));
 
 using JSON = GLZ;
 
+/**
+ * @brief types glaze can (de)serialize without a DOM: aggregates it reflects
+ *        automatically and types that declare a glz::meta object
+ */
+template <typename T>
+concept reflectable =
+    glz::reflectable<std::decay_t<T>> || glz::glaze_object_t<std::decay_t<T>>;
+
+/**
+ * @brief decode JSON straight into a glaze-reflectable @p T (aggregates, or
+ *        types with a glz::meta), without building an intermediate DOM.
+ *        Keys that @p T does not declare are skipped.
+ */
+template <typename T>
+[[nodiscard]] FLZ::expected<T, std::runtime_error> decode(std::string_view raw) {
+  T value{};
+  if (auto const ec =
+          glz::read<glz::opts{.error_on_unknown_keys = false}>(value, raw);
+      ec) {
+    return FLZ::unexpected(std::runtime_error{
+        std::format("{}:{}:{}: {}", __FILE__, __LINE__, __func__,
+                    glz::format_error(ec, raw))});
+  }
+  return value;
+}
+
 } // namespace XSON
 
 template <> struct glz::meta<XSON::GLZ::unpacked_items> {
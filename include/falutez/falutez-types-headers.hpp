@@ -1,140 +1,412 @@
 #pragma once
 
 #ifndef _UNIHEADER_BUILD_
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cstdint>
+#include <format>
+#include <map>
+#include <memory_resource>
+#include <stdexcept>
 #include <string>
+#include <string_view>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 #endif
 
 #include <falutez/falutez-serio.hpp>
 
 namespace HTTP {
+
+/**
+ * @brief FIELD - well-known header names, interned so lookups by them are a
+ *        single index load (see Headers::find(FIELD))
+ */
+enum class FIELD : uint8_t {
+  ACCEPT,
+  ACCEPT_ENCODING,
+  ACCEPT_LANGUAGE,
+  ACCEPT_RANGES,
+  AUTHORIZATION,
+  CACHE_CONTROL,
+  CONNECTION,
+  CONTENT_DISPOSITION,
+  CONTENT_ENCODING,
+  CONTENT_LENGTH,
+  CONTENT_RANGE,
+  CONTENT_TYPE,
+  COOKIE,
+  DATE,
+  ETAG,
+  EXPECT,
+  HOST,
+  IF_MATCH,
+  IF_MODIFIED_SINCE,
+  IF_NONE_MATCH,
+  IF_RANGE,
+  LAST_MODIFIED,
+  LOCATION,
+  RANGE,
+  RETRY_AFTER,
+  SERVER,
+  SET_COOKIE,
+  TRANSFER_ENCODING,
+  USER_AGENT,
+  VARY,
+  OTHER, ///< not interned; also the count of the interned ones
+};
+
+namespace internal {
+
+inline constexpr std::array<std::string_view,
+                            static_cast<size_t>(FIELD::OTHER)>
+    kFieldNames = {
+        "Accept",
+        "Accept-Encoding",
+        "Accept-Language",
+        "Accept-Ranges",
+        "Authorization",
+        "Cache-Control",
+        "Connection",
+        "Content-Disposition",
+        "Content-Encoding",
+        "Content-Length",
+        "Content-Range",
+        "Content-Type",
+        "Cookie",
+        "Date",
+        "ETag",
+        "Expect",
+        "Host",
+        "If-Match",
+        "If-Modified-Since",
+        "If-None-Match",
+        "If-Range",
+        "Last-Modified",
+        "Location",
+        "Range",
+        "Retry-After",
+        "Server",
+        "Set-Cookie",
+        "Transfer-Encoding",
+        "User-Agent",
+        "Vary",
+};
+
+constexpr char fold(char chr) noexcept {
+  return chr >= 'A' && chr <= 'Z' ? static_cast<char>(chr - 'A' + 'a') : chr;
+}
+
+constexpr bool iequals(std::string_view lhs, std::string_view rhs) noexcept {
+  return lhs.size() == rhs.size() &&
+         std::ranges::equal(lhs, rhs, [](char lhs_chr, char rhs_chr) {
+           return fold(lhs_chr) == fold(rhs_chr);
+         });
+}
+
+/// case-insensitive FNV-1a
+constexpr uint32_t ihash(std::string_view name) noexcept {
+  uint32_t hash = 2166136261U;
+  for (auto chr : name) {
+    hash ^= static_cast<uint8_t>(fold(chr));
+    hash *= 16777619U;
+  }
+  return hash;
+}
+
+/// well-known names bucketed by (length, folded first char); at most a
+/// couple of case-insensitive compares per lookup
+inline constexpr auto kFieldBuckets = [] {
+  constexpr size_t kMaxLength = 24;
+  std::array<std::array<std::array<uint8_t, 4>, 27>, kMaxLength> buckets{};
+  for (auto &by_length : buckets)
+    for (auto &bucket : by_length)
+      bucket.fill(static_cast<uint8_t>(FIELD::OTHER));
+
+  for (size_t idx = 0; idx < kFieldNames.size(); ++idx) {
+    auto const name = kFieldNames[idx];
+    auto &bucket = buckets[name.size()][fold(name.front()) - 'a'];
+    *std::ranges::find(bucket, static_cast<uint8_t>(FIELD::OTHER)) =
+        static_cast<uint8_t>(idx);
+  }
+  return buckets;
+}();
+
+constexpr FIELD field_of(std::string_view name) noexcept {
+  if (name.empty() || name.size() >= kFieldBuckets.size())
+    return FIELD::OTHER;
+  auto const first = fold(name.front());
+  if (first < 'a' || first > 'z')
+    return FIELD::OTHER;
+  for (auto const idx : kFieldBuckets[name.size()][first - 'a']) {
+    if (idx == static_cast<uint8_t>(FIELD::OTHER))
+      break;
+    if (iequals(kFieldNames[idx], name))
+      return static_cast<FIELD>(idx);
+  }
+  return FIELD::OTHER;
+}
+
+static_assert(field_of("content-type") == FIELD::CONTENT_TYPE);
+static_assert(field_of("ETAG") == FIELD::ETAG);
+static_assert(field_of("X-Request-Id") == FIELD::OTHER);
+
+} // namespace internal
+
+inline constexpr std::string_view to_string(FIELD field) {
+  return field == FIELD::OTHER
+             ? std::string_view{}
+             : internal::kFieldNames[static_cast<size_t>(field)];
+}
+
+/**
+ * @brief Headers - request/response header fields
+ * @note  names compare case-insensitively (HTTP/2 peers send them in lower
+ *        case); the first spelling seen is the one kept and sent.
+ *        Fields are stored flat, in insertion order, in one contiguous
+ *        vector. Well-known names (FIELD) are interned and found through an
+ *        index table; other names through a scan over precomputed folded
+ *        hashes.
+ * @note  allocator-aware: storage comes from the std::pmr::memory_resource
+ *        given at construction, so a request-scoped arena can back it.
+ *        Lookups never allocate.
+ */
 struct Headers {
+  using allocator_type = FLZ::allocator_type;
+  using value_type = std::pair<std::pmr::string, std::pmr::string>;
 
   /// construct from maps, other headers, or JSON
 
-  Headers(std::unordered_map<std::string, std::string> const &headers)
-      : headers_{headers} {}
-  Headers(std::unordered_map<std::string, std::string> &&headers)
-      : headers_{std::move(headers)} {}
-  Headers(std::map<std::string, std::string> const &headers)
-      : headers_{headers.begin(), headers.end()} {}
+  Headers(std::unordered_map<std::string, std::string> const &headers,
+          allocator_type alloc = {})
+      : fields_{alloc}, meta_{alloc} {
+    merge(headers);
+  }
+  Headers(std::map<std::string, std::string> const &headers,
+          allocator_type alloc = {})
+      : fields_{alloc}, meta_{alloc} {
+    merge(headers);
+  }
   Headers(
-      std::initializer_list<std::pair<std::string, std::string>> const &headers)
-      : headers_{headers.begin(), headers.end()} {}
+      std::initializer_list<std::pair<std::string, std::string>> const &headers,
+      allocator_type alloc = {})
+      : fields_{alloc}, meta_{alloc} {
+    merge(headers);
+  }
   Headers() = default;
+  explicit Headers(allocator_type alloc) : fields_{alloc}, meta_{alloc} {}
   Headers(Headers const &other) = default;
-  Headers(Headers &&other) = default;
+  /// the source is left empty: its slot table must not keep pointing into
+  /// the fields that moved away
+  Headers(Headers &&other) noexcept
+      : fields_{std::move(other.fields_)}, meta_{std::move(other.meta_)},
+        slots_{other.slots_} {
+    other.slots_.fill(0);
+  }
+  /// copy into the storage of @p alloc
+  Headers(Headers const &other, allocator_type alloc)
+      : fields_{other.fields_, alloc}, meta_{other.meta_, alloc},
+        slots_{other.slots_} {}
   Headers(XSON::XSON auto &json) { merge(json); }
 
   Headers &operator=(Headers const &other) = default;
-  Headers &operator=(Headers &&other) = default;
+  Headers &operator=(Headers &&other) {
+    if (this != &other) {
+      // with unequal allocators the vectors move element-wise and the
+      // source keeps its (moved-from) entries: drop them too
+      fields_ = std::move(other.fields_);
+      meta_ = std::move(other.meta_);
+      slots_ = other.slots_;
+      other.fields_.clear();
+      other.meta_.clear();
+      other.slots_.fill(0);
+    }
+    return *this;
+  }
+
+  [[nodiscard]] allocator_type get_allocator() const noexcept {
+    return fields_.get_allocator();
+  }
 
   /// operator[] to access/mutate by key
-  std::string &operator[](std::string const &key) { return headers_[key]; }
-  template <class K> std::string &at(K &&key) {
-    return headers_.at(std::forward<K>(key));
+  std::pmr::string &operator[](std::string_view key) {
+    if (auto *value = find(key))
+      return *value;
+    return append(key, internal::field_of(key));
+  }
+
+  std::pmr::string &operator[](FIELD field) {
+    if (auto *value = find(field))
+      return *value;
+    return append(to_string(field), field);
   }
 
   /// at() mutating or read-only access
-  std::string &at(std::string &&key) { return headers_.at(key); }
-  std::string const &at(std::string const &key) const {
-    return headers_.at(key);
+  std::pmr::string &at(std::string_view key) {
+    if (auto *value = find(key))
+      return *value;
+    throw std::out_of_range{std::format("{}:{}:{}: no header {}", __FILE__,
+                                        __LINE__, __func__, key)};
   }
-  template <class K> std::string const &at(K &&key) const {
-    return headers_.at(std::forward<K>(key));
+  std::pmr::string const &at(std::string_view key) const {
+    if (auto const *value = find(key))
+      return *value;
+    throw std::out_of_range{std::format("{}:{}:{}: no header {}", __FILE__,
+                                        __LINE__, __func__, key)};
+  }
+
+  /// value of @p key, or nullptr; never allocates
+  std::pmr::string *find(std::string_view key) {
+    return const_cast<std::pmr::string *>(std::as_const(*this).find(key));
+  }
+  std::pmr::string const *find(std::string_view key) const {
+    auto const idx = position(key, meta_of(key, internal::field_of(key)));
+    return idx < fields_.size() ? &fields_[idx].second : nullptr;
+  }
+
+  std::pmr::string *find(FIELD field) {
+    return const_cast<std::pmr::string *>(std::as_const(*this).find(field));
+  }
+  std::pmr::string const *find(FIELD field) const {
+    if (field == FIELD::OTHER)
+      return nullptr;
+    auto const slot = slots_[static_cast<size_t>(field)];
+    return slot == 0 ? nullptr : &fields_[slot - 1].second;
   }
 
   auto &set_content_length(size_t length) {
-    headers_["Content-Length"] = std::to_string(length);
+    std::array<char, 24> digits;
+    auto const [end, ec] =
+        std::to_chars(digits.data(), digits.data() + digits.size(), length);
+    (*this)[FIELD::CONTENT_LENGTH].assign(digits.data(), end);
     return *this;
   }
 
   auto content_length() const {
-    return headers_.contains("Content-Length")
-               ? std::stoul(headers_.at("Content-Length"))
-               : 0;
+    size_t length = 0;
+    if (auto const *value = find(FIELD::CONTENT_LENGTH))
+      std::from_chars(value->data(), value->data() + value->size(), length);
+    return length;
   }
 
-  auto &set_content_type(std::string const &type) {
-    headers_["Content-Type"] = type;
+  auto &set_content_type(std::string_view type) {
+    (*this)[FIELD::CONTENT_TYPE] = type;
     return *this;
   }
 
-  auto content_type() const {
-    return headers_.contains("Content-Type") ? headers_.at("Content-Type") : "";
+  std::string content_type() const {
+    auto const *value = find(FIELD::CONTENT_TYPE);
+    return value != nullptr ? std::string{*value} : "";
   }
 
-  /// other std::unordered_map methods
-  auto begin() { return headers_.begin(); }
-  auto end() { return headers_.end(); }
-  auto cbegin() const { return headers_.cbegin(); }
-  auto cend() const { return headers_.cend(); }
-  auto size() const { return headers_.size(); }
-  auto empty() const { return headers_.empty(); }
-  auto contains(std::string const &key) const { return headers_.contains(key); }
-  auto clear() { headers_.clear(); }
-  auto erase(std::string const &key) { return headers_.erase(key); }
-
-  decltype(auto) emplace(auto &&...args) {
-    return headers_.emplace(std::forward<decltype(args)>(args)...);
+  /// container interface; iteration is in insertion order
+  auto begin() { return fields_.begin(); }
+  auto end() { return fields_.end(); }
+  auto begin() const { return fields_.begin(); }
+  auto end() const { return fields_.end(); }
+  auto cbegin() const { return fields_.cbegin(); }
+  auto cend() const { return fields_.cend(); }
+  auto size() const { return fields_.size(); }
+  auto empty() const { return fields_.empty(); }
+  auto contains(std::string_view key) const { return find(key) != nullptr; }
+  auto contains(FIELD field) const { return find(field) != nullptr; }
+  auto reserve(size_t count) {
+    fields_.reserve(count);
+    meta_.reserve(count);
+  }
+  auto clear() {
+    fields_.clear();
+    meta_.clear();
+    slots_.fill(0);
+  }
+  size_t erase(std::string_view key) {
+    auto const idx = position(key, meta_of(key, internal::field_of(key)));
+    if (idx == fields_.size())
+      return 0;
+    fields_.erase(fields_.begin() + static_cast<ptrdiff_t>(idx));
+    meta_.erase(meta_.begin() + static_cast<ptrdiff_t>(idx));
+    reindex();
+    return 1;
   }
 
-  decltype(auto) insert(auto &&arg) {
-    return headers_.insert(std::forward<decltype(arg)>(arg));
+  /// insert if absent; returns {value, inserted} like map::emplace
+  std::pair<std::pmr::string *, bool> emplace(std::string_view key,
+                                              std::string_view value) {
+    if (auto *existing = find(key))
+      return {existing, false};
+    auto &inserted = append(key, internal::field_of(key));
+    inserted = value;
+    return {&inserted, true};
   }
 
   /// ingest JSON object into headers
   void merge(XSON::XSON auto &json) {
     for (auto &[key, value] : json.items()) {
       if (value.is_string()) {
-        headers_[key] = value.template get<std::string>();
+        (*this)[key] = value.template get<std::string>();
       } else if (value.is_number()) {
-        headers_[key] = std::to_string(value.template get<double>());
+        (*this)[key] = std::to_string(value.template get<double>());
       } else if (value.is_boolean()) {
-        headers_[key] = value.template get<bool>() ? "true" : "false";
+        (*this)[key] = value.template get<bool>() ? "true" : "false";
       } else {
-        headers_[key] = value.serialize();
+        (*this)[key] = value.serialize();
       }
     }
   }
 
   /// ingest from raw maps headers
   void merge(std::unordered_map<std::string, std::string> const &other) {
+    reserve(size() + other.size());
     for (const auto &[key, value] : other) {
-      headers_[key] = value;
+      (*this)[key] = value;
     }
   }
 
   void merge(std::map<std::string, std::string> const &other) {
+    reserve(size() + other.size());
     for (const auto &[key, value] : other) {
-      headers_[key] = value;
+      (*this)[key] = value;
     }
   }
 
   void merge(
       std::initializer_list<std::pair<std::string, std::string>> const &other) {
+    reserve(size() + other.size());
     for (const auto &[key, value] : other) {
-      headers_[key] = value;
+      (*this)[key] = value;
     }
   }
 
-  void merge(std::unordered_map<std::string, std::string> &&other) {
-    for (auto &[key, value] : other) {
-      headers_[std::move(key)] = std::move(value);
+  /// merge from other Headers
+  void merge(Headers const &other) {
+    reserve(size() + other.size());
+    for (size_t idx = 0; idx < other.fields_.size(); ++idx) {
+      auto const &[key, value] = other.fields_[idx];
+      if (auto *existing = find(key, other.meta_[idx]))
+        *existing = value;
+      else
+        append(key, other.meta_[idx]) = value;
     }
   }
 
-  void merge(std::map<std::string, std::string> &&other) {
-    for (auto &[key, value] : other) {
-      headers_[std::move(key)] = std::move(value);
+  void merge(Headers &&other) {
+    if (other.get_allocator() != get_allocator())
+      return merge(other);
+    reserve(size() + other.size());
+    for (size_t idx = 0; idx < other.fields_.size(); ++idx) {
+      auto &[key, value] = other.fields_[idx];
+      if (auto *existing = find(key, other.meta_[idx])) {
+        *existing = std::move(value);
+      } else {
+        fields_.emplace_back(std::move(key), std::move(value));
+        meta_.push_back(other.meta_[idx]);
+        index_last();
+      }
     }
   }
 
-  /// merge from other Headers
-  void merge(Headers const &other) { merge(other.headers_); }
-
-  void merge(Headers &&other) { merge(std::move(other.headers_)); }
-
   /// operator shortcuts
   Headers &operator+=(Headers const &other) {
     merge(other);
@@ -148,14 +420,22 @@ struct Headers {
     return result;
   }
 
+  /// same fields and values, in any order
   bool operator==(Headers const &other) const {
-    return headers_ == other.headers_;
+    if (size() != other.size())
+      return false;
+    for (size_t idx = 0; idx < fields_.size(); ++idx) {
+      auto const *value = other.find(fields_[idx].first, meta_[idx]);
+      if (value == nullptr || *value != fields_[idx].second)
+        return false;
+    }
+    return true;
   }
 
   XSON::JSON to_json() const {
     auto json = XSON::JSON{};
-    for (const auto &[key, value] : headers_) {
-      json[key] = value;
+    for (const auto &[key, value] : fields_) {
+      json[std::string_view{key}] = std::string{value};
     }
     return json;
   }
@@ -169,15 +449,84 @@ struct Headers {
 
   // conversion
   operator std::map<std::string, std::string>() const {
-    return std::map<std::string, std::string>{headers_.begin(), headers_.end()};
+    auto fields = std::map<std::string, std::string>{};
+    for (const auto &[key, value] : fields_)
+      fields.emplace(key, value);
+    return fields;
   }
 
   operator std::unordered_map<std::string, std::string>() const {
-    return headers_;
+    auto fields = std::unordered_map<std::string, std::string>{};
+    fields.reserve(fields_.size());
+    for (const auto &[key, value] : fields_)
+      fields.emplace(key, value);
+    return fields;
   }
 
 private:
-  std::unordered_map<std::string, std::string> headers_;
+  struct Meta {
+    uint32_t hash;
+    FIELD field;
+  };
+
+  static Meta meta_of(std::string_view key, FIELD field) {
+    return {.hash = internal::ihash(key), .field = field};
+  }
+
+  /// index of @p key in fields_ (fields_.size() if absent), with the
+  /// name's metadata already at hand
+  size_t position(std::string_view key, Meta meta) const {
+    if (meta.field != FIELD::OTHER) {
+      auto const slot = slots_[static_cast<size_t>(meta.field)];
+      return slot == 0 ? fields_.size() : slot - 1U;
+    }
+    for (size_t idx = 0; idx < fields_.size(); ++idx) {
+      if (meta_[idx].hash == meta.hash &&
+          internal::iequals(fields_[idx].first, key))
+        return idx;
+    }
+    return fields_.size();
+  }
+
+  std::pmr::string *find(std::string_view key, Meta meta) {
+    auto const idx = position(key, meta);
+    return idx < fields_.size() ? &fields_[idx].second : nullptr;
+  }
+  std::pmr::string const *find(std::string_view key, Meta meta) const {
+    auto const idx = position(key, meta);
+    return idx < fields_.size() ? &fields_[idx].second : nullptr;
+  }
+
+  std::pmr::string &append(std::string_view key, FIELD field) {
+    return append(key, meta_of(key, field));
+  }
+
+  std::pmr::string &append(std::string_view key, Meta meta) {
+    fields_.emplace_back(key, std::string_view{});
+    meta_.push_back(meta);
+    index_last();
+    return fields_.back().second;
+  }
+
+  void index_last() {
+    if (auto const field = meta_.back().field; field != FIELD::OTHER)
+      slots_[static_cast<size_t>(field)] =
+          static_cast<uint16_t>(fields_.size());
+  }
+
+  void reindex() {
+    slots_.fill(0);
+    for (size_t idx = 0; idx < meta_.size(); ++idx) {
+      if (meta_[idx].field != FIELD::OTHER)
+        slots_[static_cast<size_t>(meta_[idx].field)] =
+            static_cast<uint16_t>(idx + 1);
+    }
+  }
+
+  std::pmr::vector<value_type> fields_;
+  std::pmr::vector<Meta> meta_;
+  /// 1-based position in fields_ of each interned field; 0 if absent
+  std::array<uint16_t, static_cast<size_t>(FIELD::OTHER)> slots_{};
 };
 
-} // namespace HTTP
\ No newline at end of file
+} // namespace HTTP
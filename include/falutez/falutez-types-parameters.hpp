@@ -1,43 +1,80 @@
 #pragma once
 
 #ifndef _UNIHEADER_BUILD_
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <format>
+#include <memory_resource>
+#include <stdexcept>
+#include <string>
 #include <string_view>
-#include <unordered_map>
+#include <utility>
 #include <variant>
+#include <vector>
 #endif
 
 #include <falutez/falutez-serio.hpp>
 #include <falutez/falutez-types-std.hpp>
+#include <falutez/falutez-url.hpp>
 
 namespace HTTP {
 
 /**
  * @brief Parameters - path-based parameters for a request URL
+ * @note  a flat vector of owned keys and values kept in insertion order
+ *        (merging an existing key updates it in place), so a given set of
+ *        calls always renders the same query string. Allocator-aware like
+ *        Headers: keys and string values live in the
+ *        std::pmr::memory_resource given at construction.
  */
 struct Parameters {
-  using value_type = std::unordered_map<
-      std::string_view, std::variant<FLZ::int128_t, double, std::string, bool>>;
+  using allocator_type = FLZ::allocator_type;
+  using mapped_type =
+      std::variant<FLZ::int128_t, double, std::pmr::string, bool>;
+  using value_type =
+      std::pmr::vector<std::pair<std::pmr::string, mapped_type>>;
 
   value_type data() const { return params_; }
 
   Parameters() = default;
+  explicit Parameters(allocator_type alloc) : params_{alloc} {}
   Parameters(Parameters const &other) = default;
   Parameters(Parameters &&other) = default;
-  Parameters(value_type const &params) : params_{params} {}
-  Parameters(value_type &&params) : params_{std::move(params)} {}
+  Parameters(Parameters const &other, allocator_type alloc)
+      : params_{alloc} {
+    merge(other);
+  }
+  Parameters(value_type const &params) { merge(params); }
+  Parameters(value_type &&params) { merge(std::move(params)); }
+
+  [[nodiscard]] allocator_type get_allocator() const noexcept {
+    return params_.get_allocator();
+  }
 
   Parameters &operator=(Parameters const &other) = default;
   Parameters &operator=(Parameters &&other) = default;
 
+  /// set @p key, replacing its value in place if already present
+  mapped_type &set(std::string_view key, mapped_type value) {
+    if (auto *existing = find(key)) {
+      *existing = local(std::move(value));
+      return *existing;
+    }
+    return params_.emplace_back(key, local(std::move(value))).second;
+  }
+
   void merge(value_type const &other) {
+    params_.reserve(params_.size() + other.size());
     for (const auto &[key, value] : other) {
-      params_[key] = value;
+      set(key, value);
     }
   }
 
   void merge(value_type &&other) {
+    params_.reserve(params_.size() + other.size());
     for (auto &[key, value] : other) {
-      params_[std::move(key)] = std::move(value);
+      set(key, std::move(value));
     }
   }
 
@@ -56,66 +93,75 @@ struct Parameters {
     return result;
   }
 
+  /// same keys, values and order: equal parameters render equal URLs
   bool operator==(Parameters const &other) const {
     return params_ == other.params_;
   }
 
-  std::string &operator[](std::string_view const &key) {
-    return std::get<std::string>(params_.at(key));
-  }
-
-  std::string &operator[](std::string_view &&key) {
-    return std::get<std::string>(params_.at(key));
-  }
+  std::pmr::string &operator[](std::string_view key) { return at(key); }
 
-  std::string &at(std::string_view const &key) {
-    return std::get<std::string>(params_.at(key));
+  std::pmr::string &at(std::string_view key) {
+    return std::get<std::pmr::string>(checked(find(key), key));
   }
 
-  std::string &at(std::string_view &&key) {
-    return std::get<std::string>(params_.at(key));
+  std::pmr::string const &at(std::string_view key) const {
+    return std::get<std::pmr::string>(
+        checked(const_cast<Parameters *>(this)->find(key), key));
   }
 
-  std::string const &at(std::string_view const &key) const {
-    return std::get<std::string>(params_.at(key));
+  /// value of @p key, or nullptr
+  mapped_type *find(std::string_view key) {
+    for (auto &[name, value] : params_) {
+      if (name == key)
+        return &value;
+    }
+    return nullptr;
   }
 
-  std::string const &at(std::string_view &&key) const {
-    return std::get<std::string>(params_.at(key));
+  mapped_type const *find(std::string_view key) const {
+    return const_cast<Parameters *>(this)->find(key);
   }
 
   auto begin() { return params_.begin(); }
   auto end() { return params_.end(); }
+  auto begin() const { return params_.begin(); }
+  auto end() const { return params_.end(); }
   auto cbegin() const { return params_.cbegin(); }
   auto cend() const { return params_.cend(); }
   auto size() const { return params_.size(); }
   auto empty() const { return params_.empty(); }
-  auto contains(std::string const &key) const { return params_.contains(key); }
+  auto reserve(size_t count) { params_.reserve(count); }
+  bool contains(std::string_view key) const { return find(key) != nullptr; }
   auto clear() { params_.clear(); }
-  auto erase(std::string const &key) { return params_.erase(key); }
+
+  size_t erase(std::string_view key) {
+    return std::erase_if(params_,
+                         [&](auto const &entry) { return entry.first == key; });
+  }
 
   void merge(XSON::XSON auto &json) {
     for (auto &[key, value] : json.items()) {
       if (value.is_string()) {
-        params_[key] = value.template get<std::string>();
+        set(key, string_of(value.template get<std::string>()));
       } else if (value.is_number()) {
-        params_[key] = value.template get<double>();
+        set(key, value.template get<double>());
       } else if (value.is_boolean()) {
-        params_[key] = value.template get<bool>();
+        set(key, value.template get<bool>());
       } else {
-        params_[key] = value.serialize();
+        set(key, string_of(value.serialize()));
       }
     }
   }
 
   void to_json(XSON::XSON auto &json) const {
-    for (const auto &[key, value] : params_) {
+    for (const auto &[pmr_key, value] : params_) {
+      auto const key = std::string_view{pmr_key};
       if (std::holds_alternative<FLZ::int128_t>(value)) {
         json[key] = std::get<FLZ::int128_t>(value);
       } else if (std::holds_alternative<double>(value)) {
         json[key] = std::get<double>(value);
-      } else if (std::holds_alternative<std::string>(value)) {
-        json[key] = std::get<std::string>(value);
+      } else if (std::holds_alternative<std::pmr::string>(value)) {
+        json[key] = std::string{std::get<std::pmr::string>(value)};
       } else if (std::holds_alternative<bool>(value)) {
         json[key] = std::get<bool>(value);
       }
@@ -135,30 +181,89 @@ struct Parameters {
 
   std::string str() const { return to_json().dump().value_or("undefined"); }
 
+  /// `?k=v&...` with keys and values percent-encoded; empty if there are
+  /// no parameters
   std::string get_url_component() const {
     std::string url_component;
+    append_url_component(url_component);
+    return url_component;
+  }
+
+  /// append the query component to @p out, growing it once: the encoded
+  /// size is worked out up front (numbers at their widest) and the
+  /// excess trimmed afterwards
+  void append_url_component(std::string &out) const {
+    if (params_.empty())
+      return;
+
+    size_t bound = 0;
+    for (const auto &[key, value] : params_)
+      bound += 2 + internal::encoded_size(key) + encoded_bound(value);
+
+    auto const offset = out.size();
+    out.resize(offset + bound);
+
+    auto *cur = out.data() + offset;
+    auto separator = '?';
     for (const auto &[key, value] : params_) {
-      if (url_component.empty()) {
-        url_component += "?";
-      } else {
-        url_component += "&";
-      }
-      url_component += std::string{key};
-      url_component += "=";
-      if (std::holds_alternative<FLZ::int128_t>(value)) {
-        url_component += std::format("{}", std::get<FLZ::int128_t>(value));
-      } else if (std::holds_alternative<double>(value)) {
-        url_component += std::format("{}", std::get<double>(value));
-      } else if (std::holds_alternative<std::string>(value)) {
-        url_component += std::get<std::string>(value);
-      } else if (std::holds_alternative<bool>(value)) {
-        url_component += std::get<bool>(value) ? "true" : "false";
-      }
+      *cur++ = std::exchange(separator, '&');
+      cur = internal::percent_encode(key, cur);
+      *cur++ = '=';
+      cur = encode_value(value, cur);
     }
-    return url_component;
+
+    out.resize(static_cast<size_t>(cur - out.data()));
   }
 
 private:
+  static mapped_type &checked(mapped_type *value, std::string_view key) {
+    if (value == nullptr)
+      throw std::out_of_range{std::format("({}:{}:{}) no parameter '{}'",
+                                          __FILE__, __LINE__, __func__, key)};
+    return *value;
+  }
+
+  std::pmr::string string_of(std::string_view text) const {
+    return std::pmr::string{text, get_allocator()};
+  }
+
+  /// @p value with any string re-homed in this container's resource
+  /// (std::variant does not propagate allocators by itself)
+  mapped_type local(mapped_type value) const {
+    if (auto *text = std::get_if<std::pmr::string>(&value);
+        text != nullptr && text->get_allocator() != get_allocator())
+      return string_of(*text);
+    return value;
+  }
+
+  /// most bytes encode_value() may write for @p value
+  static size_t encoded_bound(mapped_type const &value) {
+    if (std::holds_alternative<FLZ::int128_t>(value))
+      return internal::kInt128Chars;
+    if (std::holds_alternative<double>(value))
+      return internal::kDoubleChars + 2; // an exponent's '+' becomes %2B
+    if (auto const *text = std::get_if<std::pmr::string>(&value))
+      return internal::encoded_size(*text);
+    return 5; // "false"
+  }
+
+  static char *encode_value(mapped_type const &value, char *out) {
+    if (auto const *integer = std::get_if<FLZ::int128_t>(&value))
+      return internal::format_int128(*integer, out);
+    if (auto const *real = std::get_if<double>(&value)) {
+      std::array<char, internal::kDoubleChars> digits{};
+      auto const *end = internal::format_double(*real, digits.data());
+      return internal::percent_encode(
+          {digits.data(), static_cast<size_t>(end - digits.data())}, out);
+    }
+    if (auto const *text = std::get_if<std::pmr::string>(&value))
+      return internal::percent_encode(*text, out);
+    auto const flag = std::get<bool>(value) ? std::string_view{"true"}
+                                            : std::string_view{"false"};
+    std::memcpy(out, flag.data(), flag.size());
+    return out + flag.size();
+  }
+
   value_type params_;
 };
 
@@ -1,6 +1,8 @@
 #pragma once
 
 #ifndef _UNIHEADER_BUILD_
+#include <cstddef>
+#include <memory_resource>
 #if __cplusplus >= 202302L
 #include <expected>
 #else
@@ -20,4 +22,8 @@ template <typename E> using unexpected = glz::unexpected<E>;
 
 using int128_t = __int128_t;
 
+/// allocator of the allocator-aware request/response types; default
+/// constructed it uses std::pmr::get_default_resource()
+using allocator_type = std::pmr::polymorphic_allocator<std::byte>;
+
 } // namespace FLZ
\ No newline at end of file
@@ -1,14 +1,29 @@
 #pragma once
 
 #ifndef _UNIHEADER_BUILD_
+#include <algorithm>
+#include <cerrno>
 #include <chrono>
+#include <cstddef>
 #include <exec/task.hpp>
+#include <functional>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <optional>
+#include <span>
 #include <sstream>
 #include <stdexec/execution.hpp>
 #include <string>
+#include <string_view>
+#include <variant>
+
+#include <unistd.h>
 #endif
 
+#include <falutez/falutez-buffer-pool.hpp>
 #include <falutez/falutez-http-status.hpp>
+#include <falutez/falutez-route.hpp>
 #include <falutez/falutez-types-headers.hpp>
 #include <falutez/falutez-types-parameters.hpp>
 #include <falutez/falutez-types-std.hpp>
@@ -41,18 +56,232 @@ inline auto to_string(METHOD m) {
   return ost.str();
 }
 
+/// wire formats for bodies serialized from typed values
+enum class FORMAT {
+  JSON,
+  BEVE, // glaze's binary format
+};
+
+namespace internal {
+/**
+ * @brief serializes a typed request body on demand; the transport calls
+ *        write() on its worker, into that worker's reusable buffer
+ */
+struct BodyWriter {
+  virtual ~BodyWriter() = default;
+
+  /// replace the contents of @p out with the serialized value
+  virtual void write(std::string &out) const = 0;
+
+  /// serialized once, on first use, for callers that want the bytes
+  std::string_view materialized() const {
+    std::call_once(once_, [this]() { write(cache_); });
+    return cache_;
+  }
+
+private:
+  mutable std::once_flag once_;
+  mutable std::string cache_;
+};
+
+template <XSON::reflectable T> struct ValueWriter final : BodyWriter {
+  ValueWriter(T value, FORMAT format)
+      : value_{std::move(value)}, format_{format} {}
+
+  void write(std::string &out) const override {
+    if (format_ == FORMAT::BEVE)
+      (void)glz::write_beve(value_, out);
+    else
+      (void)glz::write_json(value_, out);
+  }
+
+private:
+  T value_;
+  FORMAT format_;
+};
+} // namespace internal
+
+/**
+ * @brief Body - payload of a request or a response
+ * @note  a view into a shared, immutable buffer. Copying a Body (or taking a
+ *        slice() of it) only bumps a reference count; the payload itself is
+ *        copied at most once, when the Body is built from a borrowed string.
+ *        Moving a std::string in adopts its storage as-is.
+ *        A Body built from a typed value is serialized late, straight into
+ *        the sending worker's output buffer (see serialize_into()).
+ */
 struct Body {
   std::string content_type;
 
-  std::string data;
+  Body() = default;
 
-  Body(std::string_view const &raw) { data = raw; }
+  /// typed body; no DOM and no intermediate string on the send path
+  template <XSON::reflectable T>
+  explicit Body(T value, FORMAT format = FORMAT::JSON)
+      : content_type{format == FORMAT::BEVE ? "application/x-beve"
+                                            : "application/json"},
+        writer_{std::make_shared<internal::ValueWriter<std::decay_t<T>>>(
+            std::move(value), format)} {}
 
-  Body(std::string const &raw) { data = raw; }
+  Body(std::string_view const &raw) : Body{std::string{raw}} {}
 
-  Body(std::string &&raw) { data = std::move(raw); }
+  Body(const char *raw) : Body{std::string_view{raw}} {}
 
-  Body() = default;
+  Body(std::string const &raw) : Body{std::string{raw}} {}
+
+  Body(std::string &&raw) {
+    auto buffer = std::make_shared<const std::string>(std::move(raw));
+    view_ = *buffer;
+    string_ = buffer.get();
+    owner_ = std::move(buffer);
+  }
+
+  /// copy of @p raw in the storage of @p alloc (e.g. a request arena); the
+  /// resource must outlive every Body sharing the copy
+  Body(std::string_view raw, FLZ::allocator_type alloc) {
+    auto buffer = std::allocate_shared<const std::pmr::string>(alloc, raw);
+    view_ = *buffer;
+    owner_ = std::move(buffer);
+  }
+
+  /// share an already reference-counted buffer
+  Body(std::shared_ptr<const std::string> buffer) {
+    if (buffer) {
+      view_ = *buffer;
+      string_ = buffer.get();
+      owner_ = std::move(buffer);
+    }
+  }
+
+  /// view into arbitrary storage kept alive by @p owner
+  Body(std::shared_ptr<const void> owner, std::string_view view)
+      : owner_{std::move(owner)}, view_{view} {}
+
+  /// payload bytes; a typed body is serialized (once) on first access
+  [[nodiscard]] std::string_view data() const {
+    return writer_ ? writer_->materialized() : view_;
+  }
+
+  [[nodiscard]] auto size() const { return data().size(); }
+
+  [[nodiscard]] auto empty() const { return data().empty(); }
+
+  /// whether this body is a typed value serialized at send time
+  [[nodiscard]] bool deferred() const noexcept { return writer_ != nullptr; }
+
+  /// replace the contents of @p out with the payload; for typed bodies this
+  /// serializes directly into @p out (capacity is kept across calls)
+  void serialize_into(std::string &out) const {
+    if (writer_)
+      writer_->write(out);
+    else
+      out.assign(view_);
+  }
+
+  /// sub-range of this body sharing the same buffer
+  [[nodiscard]] Body slice(size_t offset,
+                           size_t length = std::string_view::npos) const {
+    auto const whole = data();
+    if (offset > whole.size())
+      throw std::out_of_range{std::format("{}:{}:{}: offset {} > size {}",
+                                          __FILE__, __LINE__, __func__, offset,
+                                          whole.size())};
+    auto sliced = Body{writer_ ? std::shared_ptr<const void>{writer_} : owner_,
+                       whole.substr(offset, length)};
+    sliced.content_type = content_type;
+    if (string_ != nullptr && sliced.view_.size() == string_->size())
+      sliced.string_ = string_;
+    return sliced;
+  }
+
+  /// the backing std::string if this body spans exactly one; nullptr otherwise
+  /// (transports with `std::string const &` APIs can then skip a copy)
+  [[nodiscard]] std::string const *as_string() const noexcept {
+    return string_;
+  }
+
+  /// number of Body instances sharing the buffer (0 if there is none)
+  [[nodiscard]] auto use_count() const noexcept {
+    return writer_ ? writer_.use_count() : owner_.use_count();
+  }
+
+  [[nodiscard]] std::string str() const { return std::string{data()}; }
+
+  bool operator==(std::string_view other) const { return data() == other; }
+
+private:
+  std::shared_ptr<const void> owner_;
+  std::string_view view_;
+  std::string const *string_ = nullptr;
+  std::shared_ptr<const internal::BodyWriter> writer_;
+};
+
+/**
+ * @brief BodySink - where a response body goes instead of
+ *        ResponseDetails::body: a file descriptor, a caller-owned region
+ *        (e.g. an mmap), or a callback. Bytes are handed over as the
+ *        transport receives them; no intermediate string is built.
+ * @note  the sink sees the body whatever the status; check
+ *        ResponseDetails::status before trusting what it received
+ */
+class BodySink {
+public:
+  /// return false to abort the transfer
+  using Callback = std::function<bool(std::span<const std::byte>)>;
+
+  /// write(2) from the descriptor's position, or pwrite(2) from @p offset
+  explicit BodySink(int fd, std::optional<off_t> offset = std::nullopt)
+      : target_{Descriptor{fd, offset}} {}
+
+  /// fill @p region from its start; a body that does not fit aborts
+  explicit BodySink(std::span<std::byte> region) : target_{region} {}
+
+  explicit BodySink(Callback callback) : target_{std::move(callback)} {}
+
+  /// false stops the transfer (I/O error, region full, callback refusal)
+  bool write(std::span<const std::byte> chunk) {
+    if (auto *region = std::get_if<std::span<std::byte>>(&target_)) {
+      if (chunk.size() > region->size() - written_) {
+        overflowed_ = true;
+        return false;
+      }
+      std::ranges::copy(chunk, region->begin() + written_);
+    } else if (auto *callback = std::get_if<Callback>(&target_)) {
+      if (!(*callback)(chunk))
+        return false;
+    } else {
+      auto const &[fd, offset] = std::get<Descriptor>(target_);
+      for (size_t done = 0; done < chunk.size();) {
+        auto const res =
+            offset.has_value()
+                ? ::pwrite(fd, chunk.data() + done, chunk.size() - done,
+                           *offset + static_cast<off_t>(written_ + done))
+                : ::write(fd, chunk.data() + done, chunk.size() - done);
+        if (res < 0 && errno == EINTR)
+          continue;
+        if (res <= 0)
+          return false;
+        done += static_cast<size_t>(res);
+      }
+    }
+    written_ += chunk.size();
+    return true;
+  }
+
+  size_t written() const { return written_; }
+
+  /// a region sink was sent more bytes than it holds
+  bool overflowed() const { return overflowed_; }
+
+private:
+  struct Descriptor {
+    int fd;
+    std::optional<off_t> offset;
+  };
+
+  std::variant<Descriptor, std::span<std::byte>, Callback> target_;
+  size_t written_ = 0;
+  bool overflowed_ = false;
 };
 
 /**
@@ -78,6 +307,8 @@ struct ResponseDetails {
   HTTP::STATUS status;
   std::optional<Headers> headers;
   std::optional<Body> body;
+  /// bytes handed to RequestSpec::sink; body is left empty when one is set
+  size_t sink_bytes = 0;
 
   std::chrono::system_clock::time_point end_time;
 
@@ -99,7 +330,9 @@ struct ResponseDetails {
     if (headers.has_value())
       json["headers"] = headers.value().to_json();
     if (body.has_value())
-      json["body"] = body.value().data;
+      json["body"] = body.value().str();
+    if (sink_bytes != 0)
+      json["sink_bytes"] = sink_bytes;
     return json;
   }
 
@@ -114,6 +347,24 @@ struct ResponseDetails {
 
 using Response = FLZ::expected<ResponseDetails, HTTP::STATUS>;
 
+/**
+ * @brief TypedResponse - a successful response whose body was decoded
+ *        directly into a T (see XSON::decode<T>)
+ * @note  details.body still refers to the raw payload (shared, not copied)
+ */
+template <typename T> struct TypedResponse {
+  ResponseDetails details;
+  T value;
+};
+
+/**
+ * @brief TypedResult - TypedResponse<T> or the reason there is none:
+ *        the transport error, the non-2xx HTTP status, or EBADMSG with the
+ *        decoder's message if the body does not fit T
+ */
+template <typename T>
+using TypedResult = FLZ::expected<TypedResponse<T>, HTTP::STATUS>;
+
 struct AsyncResponse : public exec::task<Response> {
   using exec::task<Response>::task; // inherit constructors
 
@@ -132,17 +383,27 @@ struct RequestSpec {
   std::optional<Parameters> params;
   std::optional<Headers> headers;
   std::optional<Body> body;
+  /// stream the response body here instead of into ResponseDetails::body
+  std::optional<BodySink> sink;
+  /// backs what the transport allocates for this request (merged headers,
+  /// response headers); nullptr uses the default resource. Must outlive the
+  /// Response. Typically a request-scoped std::pmr::monotonic_buffer_resource
+  /// released in one go once the response has been consumed.
+  std::pmr::memory_resource *resource = nullptr;
+  /// compiled route with its arguments bound (see HTTP::route); used
+  /// instead of path when set
+  std::optional<Route> route;
 
   XSON::JSON to_json() const {
     auto json = XSON::JSON{};
     json["method"] = to_string(method);
-    json["path"] = std::string{path};
+    json["path"] = route.has_value() ? route->str() : std::string{path};
     if (params.has_value())
       json["params"] = params.value().to_json();
     if (headers.has_value())
       json["headers"] = headers.value().to_json();
     if (body.has_value())
-      json["body"] = body.value().data;
+      json["body"] = body.value().str();
     return json;
   }
 
@@ -154,6 +415,35 @@ struct RequestSpec {
   std::string str() const { return to_json().dump().value_or("undefined"); }
 };
 
+/**
+ * @brief per-call changes to a prepared request
+ */
+struct RequestOverrides {
+  /// appended to the prepared query string
+  std::optional<Parameters> params;
+  /// overlaid on the prepared headers
+  std::optional<Headers> headers;
+  /// replaces the prepared body
+  std::optional<Body> body;
+  std::optional<BodySink> sink;
+  /// as RequestSpec::resource
+  std::pmr::memory_resource *resource = nullptr;
+};
+
+/**
+ * @brief handle returned by prepare(): a RequestSpec whose URL, header block
+ *        and method dispatch the client worked out once, to be executed any
+ *        number of times with RequestOverrides. Cheap to copy; only valid
+ *        with the client that prepared it.
+ */
+struct PreparedRequest {
+  HTTP::METHOD method = HTTP::METHOD::GET;
+  /// client that prepared it
+  void const *client = nullptr;
+  /// the client's precomputed state; opaque to callers
+  std::shared_ptr<const void> state;
+};
+
 /**
  * @brief ClientImpl concept - all implementation should abide by the interface
  *        GenericClient is statically checked at compile time  against this
@@ -0,0 +1,120 @@
+#pragma once
+
+/**
+ *  @brief  URL building blocks: RFC 3986 percent-encoding driven by a
+ *          constexpr byte table, and number formatting with std::to_chars,
+ *          written straight into caller-sized buffers.
+ */
+
+#ifndef _UNIHEADER_BUILD_
+#include <array>
+#include <charconv>
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <string_view>
+#endif
+
+#include <falutez/falutez-types-std.hpp>
+
+namespace HTTP::internal {
+
+/// true for the RFC 3986 unreserved set (ALPHA / DIGIT / "-" / "." / "_" /
+/// "~"), the bytes a query key or value may carry as-is
+inline constexpr auto kUnreserved = []() {
+  std::array<bool, 256> table{};
+  for (auto chr = 'a'; chr <= 'z'; ++chr)
+    table[static_cast<unsigned char>(chr)] = true;
+  for (auto chr = 'A'; chr <= 'Z'; ++chr)
+    table[static_cast<unsigned char>(chr)] = true;
+  for (auto chr = '0'; chr <= '9'; ++chr)
+    table[static_cast<unsigned char>(chr)] = true;
+  for (auto chr : std::string_view{"-._~"})
+    table[static_cast<unsigned char>(chr)] = true;
+  return table;
+}();
+
+/// bytes @p text occupies once percent-encoded
+constexpr size_t encoded_size(std::string_view text) noexcept {
+  size_t size = text.size();
+  for (auto chr : text)
+    size += kUnreserved[static_cast<unsigned char>(chr)] ? 0 : 2;
+  return size;
+}
+
+/// percent-encode @p text into @p out, which must have room for
+/// encoded_size(text) bytes; returns one past the last byte written.
+/// Runs of unreserved bytes are copied whole rather than byte by byte.
+inline char *percent_encode(std::string_view text, char *out) noexcept {
+  static constexpr std::string_view kHex = "0123456789ABCDEF";
+
+  auto const *cur = text.data();
+  auto const *const end = cur + text.size();
+
+  while (cur != end) {
+    auto const *run = cur;
+    while (cur != end && kUnreserved[static_cast<unsigned char>(*cur)])
+      ++cur;
+    if (cur != run) {
+      std::memcpy(out, run, static_cast<size_t>(cur - run));
+      out += cur - run;
+    }
+    if (cur == end)
+      break;
+
+    auto const byte = static_cast<unsigned char>(*cur++);
+    *out++ = '%';
+    *out++ = kHex[byte >> 4];
+    *out++ = kHex[byte & 0x0f];
+  }
+  return out;
+}
+
+/// append @p text, percent-encoded, to @p out
+inline void append_encoded(std::string &out, std::string_view text) {
+  auto const offset = out.size();
+  out.resize(offset + encoded_size(text));
+  percent_encode(text, out.data() + offset);
+}
+
+/// widest formatted FLZ::int128_t: sign and 39 digits
+inline constexpr size_t kInt128Chars = 40;
+/// widest shortest-round-trip double, e.g. "-2.2250738585072014e-308"
+inline constexpr size_t kDoubleChars = 24;
+
+/// decimal digits of @p value into @p out (room for kInt128Chars); the
+/// standard library's to_chars has no 128-bit overload to rely on
+inline char *format_int128(FLZ::int128_t value, char *out) noexcept {
+  using uint128 = unsigned __int128;
+
+  auto magnitude = value < 0 ? uint128{0} - static_cast<uint128>(value)
+                             : static_cast<uint128>(value);
+
+  if (magnitude <= UINT64_MAX) {
+    if (value < 0)
+      *out++ = '-';
+    return std::to_chars(out, out + kInt128Chars,
+                         static_cast<uint64_t>(magnitude))
+        .ptr;
+  }
+
+  std::array<char, kInt128Chars> digits{};
+  auto pos = digits.size();
+  while (magnitude != 0) {
+    digits[--pos] = static_cast<char>('0' + static_cast<int>(magnitude % 10));
+    magnitude /= 10;
+  }
+
+  if (value < 0)
+    *out++ = '-';
+  std::memcpy(out, digits.data() + pos, digits.size() - pos);
+  return out + (digits.size() - pos);
+}
+
+/// shortest round-trip form of @p value into @p out (room for
+/// kDoubleChars)
+inline char *format_double(double value, char *out) noexcept {
+  return std::to_chars(out, out + kDoubleChars, value).ptr;
+}
+
+} // namespace HTTP::internal
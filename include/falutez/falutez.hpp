@@ -7,6 +7,13 @@
 #include <falutez/falutez-generic-client.hpp>
 
 #include <falutez/falutez-impl-restclient.hpp>
+#include <falutez/falutez-serio-arena.hpp>
+#include <falutez/falutez-serio-columns.hpp>
+#include <falutez/falutez-serio-lazy.hpp>
+#include <falutez/falutez-serio-parallel.hpp>
+#include <falutez/falutez-serio-path.hpp>
+#include <falutez/falutez-serio-simd.hpp>
+#include <falutez/falutez-serio-stream.hpp>
 
 namespace HTTP {
 
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <atomic>
 #include <latch>
 #include <random>
 #include <regex>
@@ -11,6 +12,7 @@
 
 #include <gtest/gtest.h>
 
+#include <falutez/falutez-codec.hpp>
 #include <falutez/falutez-types.hpp>
 
 struct RESTFixture : public ::testing::Test {
@@ -21,6 +23,26 @@ struct RESTFixture : public ::testing::Test {
   static constexpr std::string_view kSuccessPath = "/api/v1/success";
   static constexpr std::string_view kWaitPath = "/api/v1/wait";
   static constexpr std::string_view kMaybeFailPath = "/api/v1/maybe";
+  static constexpr std::string_view kGzipPath = "/api/v1/gzip";
+  static constexpr std::string_view kGzipContent = "Hello, compressed World!";
+  static constexpr std::string_view kJsonPath = "/api/v1/json";
+  static constexpr std::string_view kJsonContent =
+      R"({"message":"Hello, World!","count":3,"extra":[1,2,3]})";
+  /// answers with the request as received (request line, headers, body)
+  static constexpr std::string_view kEchoPath = "/api/v1/echo";
+  static constexpr std::string_view kBlobPath = "/api/v1/blob";
+  static constexpr size_t kBlobSize = 256 * 1024;
+  static constexpr std::string_view kBlobETag = R"("blob-v1")";
+  /// ranged GETs of kBlobPath to answer with 503 before serving again
+  static inline std::atomic<int> blob_range_failures{0};
+  /// kBlobPath was replaced after being probed: HEAD still reports
+  /// kBlobETag, ranged GETs carrying it in If-Range get the whole object
+  static inline std::atomic<bool> blob_replaced{false};
+  /// answer HEAD requests for kBlobPath with 405, as some object stores do
+  static inline std::atomic<bool> blob_refuses_head{false};
+  /// serve kBlobPath without byte ranges: no Accept-Ranges, and a Range is
+  /// answered with the whole object
+  static inline std::atomic<bool> blob_ignores_ranges{false};
   static constexpr auto kWaitDuration =
       std::chrono::duration<double, std::milli>{200};
   static constexpr auto kSuccessMethod = HTTP::METHOD::GET;
@@ -28,6 +50,17 @@ struct RESTFixture : public ::testing::Test {
 
   std::latch server_up_latch{1};
 
+  /// deterministic, non-repeating-per-chunk content served at kBlobPath
+  static std::string const &blob_content() {
+    static auto const content = [] {
+      std::string bytes(kBlobSize, '\0');
+      for (size_t idx = 0; idx < bytes.size(); ++idx)
+        bytes[idx] = static_cast<char>((idx * 31 + idx / 251) % 256);
+      return bytes;
+    }();
+    return content;
+  }
+
   void SetUp() override {
 
     std::cerr << std::format("{}:{}:{}: Starting server\n", __FILE__, __LINE__,
@@ -200,6 +233,108 @@ struct RESTFixture : public ::testing::Test {
                 if (rd() % 2 == 0) {
                   response = "HTTP/1.0 503 Service Unavailable\r\n";
                 }
+              } else if (method == to_string(kSuccessMethod) &&
+                         path == kGzipPath) {
+                auto const packed =
+                    HTTP::CODEC::compress(HTTP::ENCODING::GZIP, kGzipContent)
+                        .value();
+                response = std::format("HTTP/1.0 200 OK\r\n"
+                                       "Content-Type: text/plain\r\n"
+                                       "Content-Encoding: gzip\r\n"
+                                       "Content-Length: {}\r\n"
+                                       "\r\n",
+                                       packed.size()) +
+                           packed;
+              } else if (path.starts_with(kEchoPath)) {
+                auto const echoed =
+                    std::string_view{request}.substr(0, bytes);
+                response = std::format("HTTP/1.0 200 OK\r\n"
+                                       "Content-Type: text/plain\r\n"
+                                       "Content-Length: {}\r\n"
+                                       "\r\n"
+                                       "{}",
+                                       echoed.size(), echoed);
+              } else if (method == "HEAD" && path == kGzipPath) {
+                // describes the coded body without sending it
+                auto const packed =
+                    HTTP::CODEC::compress(HTTP::ENCODING::GZIP, kGzipContent)
+                        .value();
+                response = std::format("HTTP/1.0 200 OK\r\n"
+                                       "Content-Type: text/plain\r\n"
+                                       "Content-Encoding: gzip\r\n"
+                                       "Content-Length: {}\r\n"
+                                       "\r\n",
+                                       packed.size());
+              } else if (method == to_string(kSuccessMethod) &&
+                         path == kJsonPath) {
+                response = std::format("HTTP/1.0 200 OK\r\n"
+                                       "Content-Type: application/json\r\n"
+                                       "Content-Length: {}\r\n"
+                                       "\r\n"
+                                       "{}",
+                                       kJsonContent.size(), kJsonContent);
+              } else if (path == kBlobPath && method == "HEAD" &&
+                         blob_refuses_head) {
+                response = "HTTP/1.0 405 Method Not Allowed\r\n"
+                           "Allow: GET\r\n"
+                           "\r\n";
+              } else if (path == kBlobPath && method == "HEAD") {
+                response = std::format("HTTP/1.0 200 OK\r\n"
+                                       "Content-Type: "
+                                       "application/octet-stream\r\n"
+                                       "Content-Length: {}\r\n"
+                                       "{}"
+                                       "ETag: {}\r\n"
+                                       "\r\n",
+                                       kBlobSize,
+                                       blob_ignores_ranges
+                                           ? ""
+                                           : "Accept-Ranges: bytes\r\n",
+                                       kBlobETag);
+              } else if (path == kBlobPath &&
+                         method == to_string(kSuccessMethod)) {
+                static const std::regex kRangeRe{
+                    R"(\r\n[Rr]ange: *bytes=(\d+)-(\d+)\r\n)",
+                    std::regex::optimize};
+                static const std::regex kIfRangeRe{
+                    R"(\r\n[Ii]f-[Rr]ange: *([^\r]*)\r\n)",
+                    std::regex::optimize};
+                auto const &blob = blob_content();
+                std::smatch if_range_match;
+                // RFC 9110 §13.1.5: a validator that no longer matches gets
+                // the full representation
+                auto const stale =
+                    blob_replaced &&
+                    std::regex_search(request, if_range_match, kIfRangeRe) &&
+                    if_range_match[1].str() == kBlobETag;
+                if (std::smatch range_match;
+                    !stale && !blob_ignores_ranges &&
+                    std::regex_search(request, range_match, kRangeRe)) {
+                  auto const first = std::stoul(range_match[1].str());
+                  auto const last =
+                      std::min(std::stoul(range_match[2].str()), kBlobSize - 1);
+                  if (blob_range_failures.fetch_sub(1) > 0) {
+                    response = "HTTP/1.0 503 Service Unavailable\r\n";
+                  } else {
+                    blob_range_failures.store(0);
+                    response =
+                        std::format("HTTP/1.0 206 Partial Content\r\n"
+                                    "Content-Type: application/octet-stream\r\n"
+                                    "Content-Range: bytes {}-{}/{}\r\n"
+                                    "Content-Length: {}\r\n"
+                                    "\r\n",
+                                    first, last, kBlobSize, last - first + 1) +
+                        blob.substr(first, last - first + 1);
+                  }
+                } else {
+                  response = std::format("HTTP/1.0 200 OK\r\n"
+                                         "Content-Type: "
+                                         "application/octet-stream\r\n"
+                                         "Content-Length: {}\r\n"
+                                         "\r\n",
+                                         kBlobSize) +
+                             blob;
+                }
               } else {
                 response = "HTTP/1.0 404 Not Found\r\n";
               }
@@ -1,6 +1,11 @@
 
+#include <array>
 #include <chrono>
 #include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <future>
+#include <iterator>
 
 #include <gtest/gtest.h>
 
@@ -217,6 +222,587 @@ TEST_F(RESTFixture, Request) {
       success_req_info.start_time - success_req_info.init_time);
 }
 
+TEST_F(RESTFixture, DecodesCompressedResponse) {
+  auto cfg = HTTP::RestClientClientConfig{};
+  cfg.base_url = std::format("http://localhost:{}", port);
+  cfg.timeout = std::chrono::milliseconds{1000};
+
+  HTTP::RestClientClient client{cfg};
+
+  auto req = client.request(HTTP::RequestSpec{.method = kSuccessMethod,
+                                              .path = kGzipPath});
+
+  auto [result] = stdexec::sync_wait(std::move(req)).value();
+
+  ASSERT_TRUE(result.has_value());
+  ASSERT_TRUE(result->status);
+  ASSERT_TRUE(result->body.has_value());
+  EXPECT_EQ(result->body->data(), kGzipContent);
+  EXPECT_EQ(result->body->content_type, "text/plain");
+  // the headers describe the decoded body
+  ASSERT_TRUE(result->headers.has_value());
+  EXPECT_EQ(result->headers->find(HTTP::FIELD::CONTENT_ENCODING), nullptr);
+  EXPECT_EQ(result->headers->content_length(), kGzipContent.size());
+
+  // a HEAD answer names the coding but has no body to decode
+  auto head = client.request(HTTP::RequestSpec{.method = HTTP::METHOD::HEAD,
+                                               .path = kGzipPath});
+
+  auto [head_result] = stdexec::sync_wait(std::move(head)).value();
+
+  ASSERT_TRUE(head_result.has_value());
+  EXPECT_TRUE(head_result->status);
+  ASSERT_TRUE(head_result->headers.has_value());
+  EXPECT_NE(head_result->headers->find(HTTP::FIELD::CONTENT_ENCODING), nullptr);
+
+  // bodies that would decode past the configured limit are refused
+  auto compression = cfg.compression;
+  compression.max_decoded_size = kGzipContent.size() - 1;
+  client.set_compression(compression);
+
+  auto capped = client.request(HTTP::RequestSpec{.method = kSuccessMethod,
+                                                 .path = kGzipPath});
+
+  auto [capped_result] = stdexec::sync_wait(std::move(capped)).value();
+
+  ASSERT_TRUE(capped_result.has_value());
+  EXPECT_EQ(capped_result->status, EMSGSIZE);
+
+  // settings replaced while requests are in flight: each request runs under
+  // one whole set of them, the old or the new
+  auto toggler = std::async(std::launch::async, [&] {
+    for (int round = 0; round < 200; ++round) {
+      compression.max_decoded_size =
+          round % 2 == 0 ? HTTP::CompressionConfig::kDefaultMaxDecodedSize
+                         : kGzipContent.size() - 1;
+      client.set_compression(compression);
+    }
+  });
+  for (int round = 0; round < 20; ++round) {
+    auto [racing] = stdexec::sync_wait(
+                        client.request(HTTP::RequestSpec{
+                            .method = kSuccessMethod, .path = kGzipPath}))
+                        .value();
+    ASSERT_TRUE(racing.has_value());
+    if (racing->status)
+      EXPECT_EQ(racing->body->data(), kGzipContent);
+    else
+      EXPECT_EQ(racing->status, EMSGSIZE);
+  }
+  toggler.get();
+}
+
+TEST_F(RESTFixture, RouteRequest) {
+  auto cfg = HTTP::RestClientClientConfig{};
+  cfg.base_url = std::format("http://localhost:{}", port);
+  cfg.timeout = std::chrono::milliseconds{1000};
+
+  HTTP::RestClientClient client{cfg};
+
+  auto req = client.request(
+      HTTP::RequestSpec{.method = kSuccessMethod,
+                        .route = HTTP::route<"/api/{version}/{name}">(
+                            "v1", kGzipPath.substr(kGzipPath.rfind('/') + 1))});
+
+  auto [result] = stdexec::sync_wait(std::move(req)).value();
+
+  ASSERT_TRUE(result.has_value());
+  ASSERT_TRUE(result->status);
+  EXPECT_EQ(result->path, kGzipPath);
+  ASSERT_TRUE(result->body.has_value());
+  EXPECT_EQ(result->body->data(), kGzipContent);
+}
+
+/// values of the header lines named @p name (any case) in an echoed request
+static std::vector<std::string> echoed(HTTP::ResponseDetails const &response,
+                                       std::string_view name) {
+  std::vector<std::string> values;
+  if (!response.body.has_value())
+    return values;
+
+  auto text = response.body->data();
+  for (auto eol = text.find("\r\n"); eol != std::string_view::npos && eol != 0;
+       eol = text.find("\r\n")) {
+    auto const line = text.substr(0, eol);
+    text.remove_prefix(eol + 2);
+    auto const colon = line.find(':');
+    if (colon == std::string_view::npos ||
+        !HTTP::internal::iequals(line.substr(0, colon), name))
+      continue;
+    auto value = line.substr(colon + 1);
+    value.remove_prefix(std::min(value.find_first_not_of(' '), value.size()));
+    values.emplace_back(value);
+  }
+  return values;
+}
+
+TEST_F(RESTFixture, HeaderBlock) {
+  auto cfg = HTTP::RestClientClientConfig{};
+  cfg.base_url = std::format("http://localhost:{}", port);
+  cfg.timeout = std::chrono::milliseconds{1000};
+  cfg.thread_pool_size = 1;
+  cfg.user_agent = "falutez-test";
+  cfg.headers["X-Trace"] = "default";
+
+  HTTP::RestClientClient client{cfg};
+
+  auto const run = [&](std::optional<HTTP::Headers> headers) {
+    auto [result] = stdexec::sync_wait(client.request(HTTP::RequestSpec{
+                                           .method = kSuccessMethod,
+                                           .path = kEchoPath,
+                                           .headers = std::move(headers)}))
+                        .value();
+    EXPECT_TRUE(result.has_value());
+    return std::move(result.value());
+  };
+
+  using Values = std::vector<std::string>;
+
+  // compiled defaults: config headers, User-Agent, negotiated encodings
+  auto const plain = run(std::nullopt);
+  EXPECT_EQ(echoed(plain, "X-Trace"), Values{"default"});
+  EXPECT_EQ(echoed(plain, "User-Agent"), Values{"falutez-test"});
+  EXPECT_EQ(echoed(plain, "Accept-Encoding"),
+            Values{std::string{HTTP::CODEC::accept_encoding()}});
+
+  // a per-call field replaces the default under any spelling, once
+  auto overlay = HTTP::Headers{};
+  overlay["x-trace"] = "call";
+  overlay["accept-encoding"] = "identity";
+  auto const overlaid = run(std::move(overlay));
+  EXPECT_EQ(echoed(overlaid, "X-Trace"), Values{"call"});
+  EXPECT_EQ(echoed(overlaid, "Accept-Encoding"), Values{"identity"});
+
+  // and does not stick to the worker's connection
+  EXPECT_EQ(echoed(run(std::nullopt), "X-Trace"), Values{"default"});
+
+  // the setters regenerate the block
+  auto replaced = HTTP::Headers{};
+  replaced["X-Other"] = "set";
+  client.set_headers(std::move(replaced));
+  client.set_user_agent("falutez-test/2");
+  auto const regenerated = run(std::nullopt);
+  EXPECT_TRUE(echoed(regenerated, "X-Trace").empty());
+  EXPECT_EQ(echoed(regenerated, "X-Other"), Values{"set"});
+  EXPECT_EQ(echoed(regenerated, "User-Agent"), Values{"falutez-test/2"});
+
+  auto compression = cfg.compression;
+  compression.accept_compressed = false;
+  client.set_compression(compression);
+  EXPECT_TRUE(echoed(run(std::nullopt), "Accept-Encoding").empty());
+}
+
+TEST_F(RESTFixture, PreparedRequest) {
+  auto cfg = HTTP::RestClientClientConfig{};
+  cfg.base_url = std::format("http://localhost:{}", port);
+  cfg.timeout = std::chrono::milliseconds{1000};
+
+  HTTP::RestClientClient client{cfg};
+
+  auto const prepared = client.prepare(HTTP::RequestSpec{
+      .method = kSuccessMethod,
+      .path = kGzipPath,
+      .headers = HTTP::Headers{{{"X-Trace", "prepared"}}}});
+
+  auto const run = [&](HTTP::RequestOverrides overrides) {
+    auto [result] =
+        stdexec::sync_wait(client.request(prepared, std::move(overrides)))
+            .value();
+    return std::move(result);
+  };
+
+  for (int round = 0; round < 3; ++round) {
+    auto result = run({});
+    ASSERT_TRUE(result.has_value());
+    ASSERT_TRUE(result->status);
+    EXPECT_EQ(result->path, kGzipPath);
+    ASSERT_TRUE(result->body.has_value());
+    EXPECT_EQ(result->body->data(), kGzipContent);
+  }
+
+  // still valid once the defaults it was compiled against have changed
+  client.set_headers(HTTP::Headers{{{"X-Client", "changed"}}});
+  auto again = run({.headers = HTTP::Headers{{{"X-Call", "1"}}}});
+  ASSERT_TRUE(again.has_value());
+  ASSERT_TRUE(again->body.has_value());
+  EXPECT_EQ(again->body->data(), kGzipContent);
+
+  // what reaches the server: prepared headers and query, overrides on top
+  auto params = HTTP::Parameters{};
+  params.set("page", std::pmr::string{"1"});
+  auto echo_headers = HTTP::Headers{};
+  echo_headers["X-Trace"] = "prepared";
+  echo_headers["Accept-Encoding"] = "gzip";
+  auto const echo = client.prepare(
+      HTTP::RequestSpec{.method = HTTP::METHOD::POST,
+                        .path = kEchoPath,
+                        .params = std::move(params),
+                        .headers = std::move(echo_headers),
+                        .body = HTTP::Body{std::string{"prepared-body"}}});
+
+  auto const run_echo = [&](HTTP::RequestOverrides overrides) {
+    auto [result] =
+        stdexec::sync_wait(client.request(echo, std::move(overrides)))
+            .value();
+    EXPECT_TRUE(result.has_value());
+    return std::move(result.value());
+  };
+
+  using Values = std::vector<std::string>;
+
+  auto const as_prepared = run_echo({});
+  ASSERT_TRUE(as_prepared.body.has_value());
+  EXPECT_TRUE(as_prepared.body->data().starts_with(
+      std::format("POST {}?page=1 ", kEchoPath)));
+  EXPECT_EQ(echoed(as_prepared, "X-Trace"), Values{"prepared"});
+  EXPECT_TRUE(as_prepared.body->data().ends_with("\r\n\r\nprepared-body"));
+
+  auto extra = HTTP::Parameters{};
+  extra.set("limit", std::pmr::string{"5"});
+  auto const overridden =
+      run_echo({.params = std::move(extra),
+                .body = HTTP::Body{std::string{"override-body"}}});
+  ASSERT_TRUE(overridden.body.has_value());
+  EXPECT_TRUE(overridden.body->data().starts_with(
+      std::format("POST {}?page=1&limit=5 ", kEchoPath)));
+  EXPECT_TRUE(overridden.body->data().ends_with("\r\n\r\noverride-body"));
+  EXPECT_EQ(overridden.body->data().find("prepared-body"), std::string::npos);
+
+  // the spec's own Accept-Encoding is kept when streaming into a sink
+  std::array<std::byte, 1024> region{};
+  auto const sunk = run_echo({.sink = HTTP::BodySink{region}});
+  ASSERT_TRUE(sunk.status);
+  auto const sunk_text = std::string_view{
+      reinterpret_cast<char const *>(region.data()), sunk.sink_bytes};
+  EXPECT_NE(sunk_text.find("Accept-Encoding: gzip\r\n"), std::string::npos);
+  EXPECT_EQ(sunk_text.find("identity"), std::string::npos);
+
+  // handles only work with the client that made them
+  HTTP::RestClientClient other{cfg};
+  auto [foreign] =
+      stdexec::sync_wait(other.request(prepared, HTTP::RequestOverrides{}))
+          .value();
+  ASSERT_FALSE(foreign.has_value());
+}
+
+namespace {
+struct Greeting {
+  std::string message;
+  int count = 0;
+};
+} // namespace
+
+TEST_F(RESTFixture, TypedRequest) {
+  auto cfg = HTTP::RestClientClientConfig{};
+  cfg.base_url = std::format("http://localhost:{}", port);
+  cfg.timeout = std::chrono::milliseconds{1000};
+
+  HTTP::RestClientClient client{cfg};
+
+  auto [result] = stdexec::sync_wait(client.request<Greeting>(HTTP::RequestSpec{
+                                         .method = kSuccessMethod,
+                                         .path = kJsonPath}))
+                      .value();
+
+  ASSERT_TRUE(result.has_value()) << result.error().str();
+  EXPECT_EQ(result->value.message, "Hello, World!");
+  EXPECT_EQ(result->value.count, 3);
+  EXPECT_EQ(result->details.status, HTTP::STATUS::OK);
+
+  // non-2xx responses surface their status in the error channel
+  auto [missing] = stdexec::sync_wait(client.request<Greeting>(HTTP::RequestSpec{
+                                          .method = kSuccessMethod,
+                                          .path = "/api/v1/absent"}))
+                       .value();
+
+  ASSERT_FALSE(missing.has_value());
+  EXPECT_EQ(missing.error(), HTTP::STATUS::NOT_FOUND);
+
+  // a body that does not fit the type is a decode error, not an exception
+  auto [mismatch] = stdexec::sync_wait(client.request<int>(HTTP::RequestSpec{
+                                           .method = kSuccessMethod,
+                                           .path = kJsonPath}))
+                        .value();
+
+  ASSERT_FALSE(mismatch.has_value());
+  EXPECT_EQ(mismatch.error(), EBADMSG);
+}
+
+TEST_F(RESTFixture, SinkRequest) {
+  auto cfg = HTTP::RestClientClientConfig{};
+  cfg.base_url = std::format("http://localhost:{}", port);
+  cfg.timeout = std::chrono::milliseconds{1000};
+
+  HTTP::RestClientClient client{cfg};
+
+  std::string received;
+  auto [streamed] =
+      stdexec::sync_wait(
+          client.request(HTTP::RequestSpec{
+              .method = kSuccessMethod,
+              .path = kJsonPath,
+              .sink = HTTP::BodySink{[&](std::span<const std::byte> chunk) {
+                received.append(reinterpret_cast<char const *>(chunk.data()),
+                                chunk.size());
+                return true;
+              }}}))
+          .value();
+
+  ASSERT_TRUE(streamed.has_value());
+  EXPECT_TRUE(streamed->status);
+  EXPECT_FALSE(streamed->body.has_value());
+  EXPECT_EQ(streamed->sink_bytes, kJsonContent.size());
+  EXPECT_EQ(received, kJsonContent);
+
+  // a region too small for the body aborts the transfer
+  std::array<std::byte, 8> region{};
+  auto [overflow] = stdexec::sync_wait(client.request(HTTP::RequestSpec{
+                                           .method = kSuccessMethod,
+                                           .path = kJsonPath,
+                                           .sink = HTTP::BodySink{region}}))
+                        .value();
+
+  ASSERT_TRUE(overflow.has_value());
+  EXPECT_FALSE(overflow->status);
+  EXPECT_LE(overflow->sink_bytes, region.size());
+}
+
+static std::string read_file(std::filesystem::path const &path) {
+  std::ifstream in{path, std::ios::binary};
+  return std::string{std::istreambuf_iterator<char>{in}, {}};
+}
+
+TEST_F(RESTFixture, RangedDownload) {
+  auto cfg = HTTP::RestClientClientConfig{};
+  cfg.base_url = std::format("http://localhost:{}", port);
+  cfg.timeout = std::chrono::milliseconds{2000};
+  cfg.thread_pool_size = 4;
+
+  HTTP::RestClientClient client{cfg};
+
+  auto const destination = std::filesystem::temp_directory_path() /
+                           std::format("falutez-download-{}", port);
+  std::filesystem::remove(destination);
+
+  // 16 ranges over 4 workers, two of them failing once before succeeding
+  blob_range_failures = 2;
+
+  auto [result] = stdexec::sync_wait(client.download(HTTP::DownloadSpec{
+                                         .path = std::string{kBlobPath},
+                                         .destination = destination,
+                                         .chunk_size = kBlobSize / 16,
+                                         .retry_backoff = {}}))
+                      .value();
+
+  ASSERT_TRUE(result.has_value()) << result.error().str();
+  EXPECT_TRUE(result->ranged);
+  EXPECT_EQ(result->size, kBlobSize);
+  EXPECT_EQ(result->ranges, 16U);
+  EXPECT_EQ(result->ranges_resumed, 0U);
+  EXPECT_EQ(result->retries, 2U);
+  EXPECT_EQ(read_file(destination), blob_content());
+  EXPECT_FALSE(std::filesystem::exists(destination.string() + ".falutez-part"));
+
+  std::filesystem::remove(destination);
+}
+
+TEST_F(RESTFixture, ResumedDownload) {
+  auto cfg = HTTP::RestClientClientConfig{};
+  cfg.base_url = std::format("http://localhost:{}", port);
+  cfg.timeout = std::chrono::milliseconds{2000};
+  cfg.thread_pool_size = 1;
+
+  HTTP::RestClientClient client{cfg};
+
+  auto const destination = std::filesystem::temp_directory_path() /
+                           std::format("falutez-resume-{}", port);
+  std::filesystem::remove(destination);
+
+  auto spec = HTTP::DownloadSpec{.path = std::string{kBlobPath},
+                                 .destination = destination,
+                                 .chunk_size = kBlobSize / 8,
+                                 .max_retries = 0,
+                                 .retry_backoff = {}};
+
+  // first two ranges fail without retries; the other six land on disk
+  blob_range_failures = 2;
+
+  auto [interrupted] = stdexec::sync_wait(client.download(spec)).value();
+
+  ASSERT_FALSE(interrupted.has_value());
+  EXPECT_EQ(interrupted.error(), HTTP::STATUS::SERVICE_UNAVAILABLE);
+  EXPECT_TRUE(std::filesystem::exists(destination.string() + ".falutez-part"));
+
+  auto [resumed] = stdexec::sync_wait(client.download(spec)).value();
+
+  ASSERT_TRUE(resumed.has_value()) << resumed.error().str();
+  EXPECT_EQ(resumed->ranges, 8U);
+  EXPECT_EQ(resumed->ranges_resumed, 6U);
+  EXPECT_EQ(read_file(destination), blob_content());
+
+  std::filesystem::remove(destination);
+}
+
+TEST_F(RESTFixture, DownloadOfChangedObject) {
+  auto cfg = HTTP::RestClientClientConfig{};
+  cfg.base_url = std::format("http://localhost:{}", port);
+  cfg.timeout = std::chrono::milliseconds{2000};
+  cfg.thread_pool_size = 2;
+
+  HTTP::RestClientClient client{cfg};
+
+  auto const destination = std::filesystem::temp_directory_path() /
+                           std::format("falutez-changed-{}", port);
+  std::filesystem::remove(destination);
+
+  // the ETag from the probe no longer matches: every range comes back as a
+  // 200 with the whole (new) object, larger than the range's region
+  blob_replaced = true;
+
+  auto [result] = stdexec::sync_wait(client.download(HTTP::DownloadSpec{
+                                         .path = std::string{kBlobPath},
+                                         .destination = destination,
+                                         .chunk_size = kBlobSize / 4,
+                                         .retry_backoff = {}}))
+                      .value();
+
+  blob_replaced = false;
+
+  ASSERT_FALSE(result.has_value());
+  EXPECT_EQ(result.error(), ESTALE) << result.error().str();
+
+  std::filesystem::remove(destination);
+  std::filesystem::remove(destination.string() + ".falutez-part");
+}
+
+TEST_F(RESTFixture, DownloadWithoutHead) {
+  auto cfg = HTTP::RestClientClientConfig{};
+  cfg.base_url = std::format("http://localhost:{}", port);
+  cfg.timeout = std::chrono::milliseconds{2000};
+  cfg.thread_pool_size = 2;
+
+  HTTP::RestClientClient client{cfg};
+
+  auto const destination = std::filesystem::temp_directory_path() /
+                           std::format("falutez-nohead-{}", port);
+  std::filesystem::remove(destination);
+
+  // the size comes from the Content-Range of a one-byte ranged GET instead
+  blob_refuses_head = true;
+
+  auto [result] = stdexec::sync_wait(client.download(HTTP::DownloadSpec{
+                                         .path = std::string{kBlobPath},
+                                         .destination = destination,
+                                         .chunk_size = kBlobSize / 4,
+                                         .retry_backoff = {}}))
+                      .value();
+
+  blob_refuses_head = false;
+
+  ASSERT_TRUE(result.has_value()) << result.error().str();
+  EXPECT_TRUE(result->ranged);
+  EXPECT_EQ(result->size, kBlobSize);
+  EXPECT_EQ(result->ranges, 4U);
+  EXPECT_EQ(read_file(destination), blob_content());
+
+  std::filesystem::remove(destination);
+}
+
+TEST_F(RESTFixture, DownloadWithoutRanges) {
+  auto cfg = HTTP::RestClientClientConfig{};
+  cfg.base_url = std::format("http://localhost:{}", port);
+  cfg.timeout = std::chrono::milliseconds{2000};
+  cfg.thread_pool_size = 2;
+
+  HTTP::RestClientClient client{cfg};
+
+  auto const destination = std::filesystem::temp_directory_path() /
+                           std::format("falutez-noranges-{}", port);
+  auto const journal = destination.string() + ".falutez-part";
+
+  blob_ignores_ranges = true;
+
+  // once without Accept-Ranges on the HEAD, once with the probe's one-byte
+  // range answered by the whole object
+  for (bool refuses_head : {false, true}) {
+    SCOPED_TRACE(refuses_head);
+    blob_refuses_head = refuses_head;
+
+    // a longer leftover and the journal of an earlier ranged run
+    std::ofstream{destination, std::ios::binary}
+        << std::string(2 * kBlobSize, 'x');
+    std::ofstream{journal} << "falutez-part 1 stale\n";
+
+    auto [result] = stdexec::sync_wait(client.download(HTTP::DownloadSpec{
+                                           .path = std::string{kBlobPath},
+                                           .destination = destination,
+                                           .chunk_size = kBlobSize / 4,
+                                           .retry_backoff = {}}))
+                        .value();
+
+    ASSERT_TRUE(result.has_value()) << result.error().str();
+    EXPECT_FALSE(result->ranged);
+    EXPECT_EQ(result->size, kBlobSize);
+    EXPECT_EQ(result->ranges, 1U);
+    EXPECT_EQ(read_file(destination), blob_content());
+    EXPECT_FALSE(std::filesystem::exists(journal));
+  }
+
+  blob_ignores_ranges = false;
+  blob_refuses_head = false;
+
+  std::filesystem::remove(destination);
+}
+
+TEST_F(RESTFixture, DownloadBackoffKeepsPoolFree) {
+  auto cfg = HTTP::RestClientClientConfig{};
+  cfg.base_url = std::format("http://localhost:{}", port);
+  cfg.timeout = std::chrono::milliseconds{2000};
+  cfg.thread_pool_size = 1;
+
+  HTTP::RestClientClient client{cfg};
+
+  auto const destination = std::filesystem::temp_directory_path() /
+                           std::format("falutez-backoff-{}", port);
+  std::filesystem::remove(destination);
+
+  constexpr auto kBackoff = std::chrono::milliseconds{500};
+  blob_range_failures = 1;
+
+  auto download = std::async(std::launch::async, [&] {
+    return stdexec::sync_wait(
+               client.download(HTTP::DownloadSpec{
+                   .path = std::string{kBlobPath},
+                   .destination = destination,
+                   .chunk_size = kBlobSize,
+                   .retry_backoff = kBackoff}))
+        .value();
+  });
+
+  // wait for the failed first attempt, then use the single worker while
+  // the download backs off
+  while (blob_range_failures.load() > 0)
+    std::this_thread::sleep_for(std::chrono::milliseconds{5});
+
+  auto const started = std::chrono::steady_clock::now();
+  auto [other] = stdexec::sync_wait(
+                     client.request(HTTP::RequestSpec{.method = kSuccessMethod,
+                                                      .path = kSuccessPath}))
+                     .value();
+  auto const waited = std::chrono::steady_clock::now() - started;
+
+  ASSERT_TRUE(other.has_value());
+  EXPECT_TRUE(other->status);
+  EXPECT_LT(waited, kBackoff / 2);
+
+  auto [result] = download.get();
+  ASSERT_TRUE(result.has_value()) << result.error().str();
+  EXPECT_EQ(result->retries, 1U);
+  EXPECT_EQ(read_file(destination), blob_content());
+
+  std::filesystem::remove(destination);
+}
+
 int main(int argc, char **argv) {
   ::testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
@@ -4,10 +4,18 @@
 #include <cpptrace.hpp>
 #include <utils.hpp>
 
+#include <falutez/falutez-serio-arena.hpp>
+#include <falutez/falutez-serio-columns.hpp>
+#include <falutez/falutez-serio-lazy.hpp>
+#include <falutez/falutez-serio-parallel.hpp>
+#include <falutez/falutez-serio-path.hpp>
+#include <falutez/falutez-serio-simd.hpp>
+#include <falutez/falutez-serio-stream.hpp>
 #include <falutez/falutez-serio.hpp>
 
 // templated test case
-using XSONTypes = ::testing::Types<XSON::NLH, XSON::GLZ>;
+using XSONTypes = ::testing::Types<XSON::NLH, XSON::GLZ, XSON::LAZY, XSON::ARENA,
+                                    XSON::SIMD>;
 template <typename T> struct XSONTest : public ::testing::Test {};
 
 TYPED_TEST_SUITE(XSONTest, XSONTypes);
@@ -279,6 +287,28 @@ TYPED_TEST(XSONTest, Access) {
   obj["key5"].get_array().emplace_back(4);
   EXPECT_EQ(obj["key5"][3], 4);
   EXPECT_EQ(arr.size(), 4);
+
+  // as in NLH, writing past the end pads with nulls
+  obj["key5"][5] = "x";
+  EXPECT_EQ(obj["key5"].size(), 6);
+  EXPECT_TRUE(obj["key5"][4].is_null());
+  EXPECT_EQ(obj["key5"][5], "x");
+
+  TypeParam grown{};
+  grown[2] = 7;
+  ASSERT_TRUE(grown.is_array());
+  EXPECT_EQ(grown.size(), 3);
+  EXPECT_TRUE(grown[0].is_null());
+  EXPECT_EQ(grown[2], 7);
+
+  // and a repeated key resolves to its last occurrence
+  auto dup = TypeParam::parse(R"({"a":1,"b":true,"a":2})");
+  EXPECT_EQ(dup.at("a"), 2);
+  EXPECT_EQ(std::as_const(dup)["a"], 2);
+  ASSERT_NE(dup.find("a"), nullptr);
+  EXPECT_EQ(*dup.find("a"), 2);
+  dup["a"] = 3;
+  EXPECT_EQ(dup.at("a"), 3);
 }
 
 TYPED_TEST(XSONTest, Coerce) {
@@ -336,6 +366,66 @@ TYPED_TEST(XSONTest, Coerce) {
   EXPECT_EQ(obj["key7"].template coerce<std::string>().value(), "true");
   ASSERT_TRUE(obj["key7"].template coerce<bool>().has_value());
   EXPECT_EQ(obj["key7"].template coerce<bool>().value(), true);
+
+  // strings must spell the whole number, in range for the requested type
+  auto const numbers =
+      TypeParam::parse(R"({"tail":"42abc","wide":"300","sign":"-1"})");
+  EXPECT_FALSE(numbers.at("tail").template coerce<int>().has_value());
+  EXPECT_FALSE(numbers.at("wide").template coerce<int8_t>().has_value());
+  EXPECT_FALSE(numbers.at("sign").template coerce<uint32_t>().has_value());
+  EXPECT_EQ(numbers.at("sign").template coerce<int32_t>().value(), -1);
+}
+
+TYPED_TEST(XSONTest, NonThrowing) {
+  auto parsed =
+      TypeParam::try_parse(R"({"id":7,"name":"x","ok":true,"tags":[1]})");
+  ASSERT_TRUE(parsed.has_value());
+  auto const &obj = *parsed;
+
+  ASSERT_NE(obj.find("id"), nullptr);
+  EXPECT_EQ(*obj.find("id"), 7);
+  EXPECT_EQ(obj.find("missing"), nullptr);
+  EXPECT_EQ(obj.at("tags").find("id"), nullptr);
+  EXPECT_EQ(obj.at("id").find("id"), nullptr);
+
+  EXPECT_EQ(obj.at("id").template try_get<int64_t>().value(), 7);
+  EXPECT_EQ(obj.at("id").template try_get<double>().value(), 7.0);
+  EXPECT_EQ(obj.at("name").template try_get<std::string>().value(), "x");
+  EXPECT_TRUE(obj.at("ok").template try_get<bool>().value());
+  EXPECT_FALSE(obj.at("name").template try_get<int64_t>().has_value());
+  EXPECT_FALSE(obj.at("id").template try_get<std::string>().has_value());
+  EXPECT_FALSE(obj.at("tags").template try_get<bool>().has_value());
+
+  // integral types take only whole numbers within their range
+  auto const numbers = TypeParam::parse(
+      R"({"frac":1.5,"byte":300,"huge":1e300,"whole":2.0,"neg":-128,)"
+      R"("min":-9223372036854775808,"big":9223372036854775808})");
+  EXPECT_FALSE(numbers.at("frac").template try_get<int64_t>().has_value());
+  EXPECT_EQ(numbers.at("frac").template try_get<double>().value(), 1.5);
+  EXPECT_FALSE(numbers.at("byte").template try_get<int8_t>().has_value());
+  EXPECT_EQ(numbers.at("byte").template try_get<int16_t>().value(), 300);
+  EXPECT_FALSE(numbers.at("huge").template try_get<int64_t>().has_value());
+  EXPECT_FALSE(numbers.at("huge").template try_get<uint64_t>().has_value());
+  EXPECT_EQ(numbers.at("whole").template try_get<int64_t>().value(), 2);
+  EXPECT_EQ(numbers.at("neg").template try_get<int8_t>().value(), -128);
+  EXPECT_FALSE(numbers.at("neg").template try_get<uint32_t>().has_value());
+  EXPECT_FALSE(numbers.at("big").template try_get<int64_t>().has_value());
+  EXPECT_EQ(numbers.at("min").template try_get<int64_t>().value(),
+            std::numeric_limits<int64_t>::min());
+  EXPECT_EQ(numbers.at("big").template try_get<uint64_t>().value(),
+            uint64_t{1} << 63);
+
+  // the error names what went wrong, without copying the source into it
+  auto const filler = std::string(4096, 'f');
+  auto const broken =
+      TypeParam::try_parse(R"({"big":")" + filler + R"(","cut":)");
+  ASSERT_FALSE(broken.has_value());
+  EXPECT_EQ(std::string_view{broken.error().what()}.find("ffff"),
+            std::string_view::npos);
+
+  EXPECT_FALSE(TypeParam::try_parse("").has_value());
+  EXPECT_FALSE(TypeParam::try_parse(R"({"a" 1})").has_value());
+  EXPECT_ANY_THROW((void)TypeParam::parse(R"({"a" 1})"));
 }
 
 TYPED_TEST(XSONTest, SERDE) {
@@ -360,6 +450,486 @@ TYPED_TEST(XSONTest, SERDE) {
   EXPECT_EQ(obj.serialize(), "{\"key\":\"value\",\"key2\":42,\"key3\":3.14}");
 }
 
+TYPED_TEST(XSONTest, Stream) {
+  const std::string raw = R"( [ {"id":1,"tags":["a,]","b\\"],"m":{"k":[]}},
+    "x\"]y", -1.5e3 ,true,null , [[1],[2,{"z":"}"}]], {} ] )";
+  const std::vector<std::string_view> expected = {
+      R"({"id":1,"tags":["a,]","b\\"],"m":{"k":[]}})",
+      R"("x\"]y")",
+      "-1.5e3",
+      "true",
+      "null",
+      R"([[1],[2,{"z":"}"}]])",
+      "{}"};
+
+  // every chunk size splits the input at a different set of boundaries
+  for (size_t chunk = 1; chunk <= raw.size(); ++chunk) {
+    XSON::ArrayStream stream;
+    std::vector<TypeParam> elements;
+    for (size_t pos = 0; pos < raw.size(); pos += chunk) {
+      stream.feed(std::string_view{raw}.substr(pos, chunk));
+      while (auto elm = stream.template next<TypeParam>())
+        elements.push_back(std::move(*elm));
+    }
+    stream.finish();
+    EXPECT_TRUE(stream.done());
+
+    ASSERT_EQ(elements.size(), expected.size()) << chunk;
+    for (size_t i = 0; i < expected.size(); ++i)
+      EXPECT_EQ(elements[i].serialize(),
+                TypeParam::parse(expected[i]).serialize())
+          << chunk;
+  }
+}
+
+TYPED_TEST(XSONTest, Parallel) {
+  std::vector<std::string> records;
+  for (int idx = 0; idx < 500; ++idx) {
+    auto const id = std::to_string(idx);
+    records.push_back(R"({"id":)" + id + R"(,"s":"a,\"]{)" + id +
+                      R"(","v":[)" + std::to_string(idx * 0.5) + R"(,[{}]]})");
+  }
+  std::string array = "[";
+  std::string ndjson;
+  for (auto const &record : records) {
+    if (array.size() > 1)
+      array += " ,\n ";
+    array += record;
+    ndjson += record + "\r\n\n";
+  }
+  array += " ]";
+
+  exec::static_thread_pool pool{4};
+  // grains small enough that every run holds only a few records
+  for (size_t grain : {size_t{1}, size_t{100}, size_t{1} << 20}) {
+    auto const from_array = XSON::parse_array<TypeParam>(array, pool, grain);
+    auto const from_lines = XSON::parse_ndjson<TypeParam>(ndjson, pool, grain);
+    ASSERT_EQ(from_array.size(), records.size()) << grain;
+    ASSERT_EQ(from_lines.size(), records.size()) << grain;
+    for (size_t i = 0; i < records.size(); ++i) {
+      auto const expected = TypeParam::parse(records[i]).serialize();
+      EXPECT_EQ(from_array[i].serialize(), expected) << grain;
+      EXPECT_EQ(from_lines[i].serialize(), expected) << grain;
+    }
+  }
+}
+
+TYPED_TEST(XSONTest, Path) {
+  auto doc = TypeParam::parse(R"({
+    "data": {"items": [{"price": 1.5}, {"price": 2}, {}, {"price": 12.5}],
+             "a/b": {"m~n": "slash and tilde"}, "0": "key, not index"},
+    "": "empty key"
+  })");
+
+  auto const price = XSON::Path{"/data/items/3/price"};
+  auto const *found = price.find(std::as_const(doc));
+  ASSERT_NE(found, nullptr);
+  EXPECT_EQ(found->template get<double>(), 12.5);
+
+  EXPECT_EQ(XSON::Path{}.find(doc), &doc);
+  EXPECT_EQ(*XSON::Path{"/data/a~1b/m~0n"}.find(doc), "slash and tilde");
+  EXPECT_EQ(*XSON::Path{"/data/0"}.find(doc), "key, not index");
+  EXPECT_EQ(*XSON::Path{"/"}.find(doc), "empty key");
+
+  for (const auto *const missing :
+       {"/data/items/4/price", "/data/items/2/price", "/data/items/x",
+        "/data/items/01", "/data/items/-", "/nope", "/data/0/0"}) {
+    EXPECT_EQ(XSON::Path{missing}.find(doc), nullptr) << missing;
+  }
+
+  // found values are the document's own
+  *XSON::Path{"/data/items/0/price"}.find(doc) = 3;
+  EXPECT_EQ(doc["data"]["items"][0]["price"], 3);
+}
+
+TEST(XSON, LazyOnDemand) {
+  const auto *const raw = R"( {
+    "name" : "a\u00e9\"b",
+    "big" : [ 1, 2.5, {"deep" : [true, false, null]} ],
+    "n" : -12
+  } )";
+
+  auto obj = XSON::LAZY::parse(raw);
+
+  // nothing touched: the text comes back minified
+  EXPECT_EQ(
+      obj.serialize(),
+      R"({"name":"a\u00e9\"b","big":[1,2.5,{"deep":[true,false,null]}],"n":-12})");
+
+  // touched values are re-encoded, the rest is still copied through
+  EXPECT_EQ(obj["n"], -12);
+  obj["n"] = 7;
+  EXPECT_EQ(
+      obj.serialize(),
+      R"({"name":"a\u00e9\"b","big":[1,2.5,{"deep":[true,false,null]}],"n":7})");
+
+  // 128-bit integers stay integers while they fit in 64 bits
+  obj["n"] = FLZ::int128_t{42};
+  EXPECT_TRUE(obj["n"].is_number_integer());
+  EXPECT_EQ(obj["n"].serialize(), "42");
+  obj["n"] = FLZ::int128_t{1} << 100;
+  EXPECT_TRUE(obj["n"].is_number_float());
+  EXPECT_EQ(obj["n"].get<double>(), std::ldexp(1.0, 100));
+
+  EXPECT_EQ(obj["name"], "a\xc3\xa9\"b");
+  EXPECT_TRUE(obj["big"][2]["deep"][0] == true);
+  EXPECT_TRUE(obj["big"][2]["deep"][2].is_null());
+
+  // a raw subtree keeps the source alive after the document is gone
+  auto big = XSON::LAZY{};
+  {
+    auto doc = XSON::LAZY::parse(raw);
+    big = doc["big"];
+  }
+  EXPECT_EQ(big.size(), 3);
+  EXPECT_EQ(big[1], 2.5);
+  EXPECT_EQ(big, XSON::LAZY::parse(R"([1,2.5,{"deep":[true,false,null]}])"));
+}
+
+TEST(XSON, LazyRejectsMalformed) {
+  for (const auto *const raw :
+       {"", "{", R"({"a":})", R"({"a" 1})", "[1,]", "[1 2]", R"("\x")",
+        "01", "1.", "-", "tru", R"({"a":1}x)", R"({"a":1,})"}) {
+    EXPECT_THROW(XSON::LAZY::parse(raw), std::runtime_error) << raw;
+  }
+}
+
+TEST(XSON, RejectsInvalidStrings) {
+  // raw control characters and unpaired surrogates are not JSON; every
+  // backend refuses them alike
+  auto const check = [](auto parse) {
+    for (std::string_view const bad :
+         {"\"a\x01b\"", "[\"\t\"]", "{\"k\x1f\":1}", R"("\ud800")",
+          R"("\ud800x")", R"("\udc00")", R"(["\ud83d\u0041"])",
+          R"({"\udfff":1})"}) {
+      EXPECT_FALSE(parse(bad)) << bad;
+    }
+    EXPECT_TRUE(parse(R"(["\ud83d\ude00","\u001f",{"\t":"\u00e9"}])"));
+  };
+
+  check([](std::string_view raw) {
+    return XSON::NLH::try_parse(raw).has_value();
+  });
+  check([](std::string_view raw) {
+    return XSON::LAZY::try_parse(raw).has_value();
+  });
+  check([](std::string_view raw) {
+    return XSON::ARENA::try_parse(raw).has_value();
+  });
+  check([](std::string_view raw) {
+    return XSON::SIMD::try_parse(raw).has_value();
+  });
+
+  EXPECT_EQ(XSON::LAZY::parse(R"(["\ud83d\ude00"])")[0], "\xf0\x9f\x98\x80");
+}
+
+TEST(XSON, SimdEncoding) {
+  const auto *const raw = R"([
+    {"s" : "a\u00e9\"\ud83d\ude00", "i" : -9223372036854775808,
+     "u" : 18446744073709551615, "d" : 2.5e-3, "e" : 1E2,
+     "nested" : {"empty" : [], "none" : {}, "flags" : [true, false, null]}}
+  ])";
+
+  // encoded from the tape, as ARENA encodes its nodes
+  auto const simd = XSON::SIMD::parse(raw);
+  EXPECT_EQ(simd.serialize(), XSON::ARENA::parse(raw).serialize());
+  EXPECT_EQ(simd[0]["i"].get<int64_t>(), INT64_MIN);
+  EXPECT_TRUE(simd[0]["u"].is_number_float());
+  EXPECT_EQ(simd[0]["s"], "a\xc3\xa9\"\xf0\x9f\x98\x80");
+
+  for (const auto *const bad : {"", "[1,]", R"({"a" 1})", "01", "tru"}) {
+    EXPECT_THROW(XSON::SIMD::parse(bad), std::runtime_error) << bad;
+  }
+}
+
+TEST(XSON, ArenaOwnership) {
+  const auto *const raw = R"({"name":"a\u00e9","big":[1,2.5,{"deep":[true]}]})";
+
+  auto doc = XSON::ARENA::parse(raw);
+  EXPECT_EQ(doc["name"], "a\xc3\xa9");
+
+  // children live in the document; copying one out detaches it
+  auto big = XSON::ARENA{};
+  {
+    auto other = XSON::ARENA::parse(raw);
+    big = other["big"];
+  }
+  EXPECT_EQ(big, XSON::ARENA::parse(R"([1,2.5,{"deep":[true]}])"));
+
+  // copies are independent
+  auto copy = doc;
+  copy["big"][0] = "one";
+  copy["added"] = XSON::ARENA::array_t{1, 2};
+  EXPECT_EQ(doc["big"][0], 1);
+  EXPECT_FALSE(doc.contains("added"));
+  EXPECT_EQ(copy.serialize(),
+            R"({"name":"aé","big":["one",2.5,{"deep":[true]}],"added":[1,2]})");
+
+  // growing a parsed container keeps its elements
+  auto &elements = doc["big"].get_array();
+  for (int idx = 0; idx < 100; ++idx)
+    elements.emplace_back(idx);
+  EXPECT_EQ(elements.size(), 103);
+  EXPECT_EQ(doc["big"][2]["deep"][0], true);
+  EXPECT_EQ(doc["big"][102], 99);
+
+  // assigning a subtree into its own document
+  doc["name"] = doc["big"][2];
+  EXPECT_EQ(doc["name"].serialize(), R"({"deep":[true]})");
+
+  // malformed input leaves the value untouched
+  EXPECT_THROW(doc.deserialize(R"({"a":1,})"), std::runtime_error);
+  EXPECT_EQ(doc["big"].size(), 103);
+}
+
+TEST(XSON, ArenaShapes) {
+  auto shapes = std::make_shared<XSON::ARENA::Shapes>();
+  const auto *const raw = R"([{"id":1,"n\u0061me":"a"},{"id":2,"name":"b"},
+                              {"name":"c","id":3},{}])";
+
+  auto first = XSON::ARENA::parse(raw, shapes);
+  auto second = XSON::ARENA::parse(raw, shapes);
+  EXPECT_EQ(shapes->size(), 2); // member order is part of the shape
+  EXPECT_EQ(first, second);
+  EXPECT_EQ(first.serialize(), XSON::ARENA::parse(raw).serialize());
+
+  // a slot handle is reused across objects of the same shape and re-resolved
+  // for the others
+  auto const name = XSON::ARENA::Field{"name"};
+  for (auto const &[idx, expected] : {std::pair{0, "a"}, {1, "b"}, {2, "c"}})
+    EXPECT_EQ(first[idx].at(name), expected);
+  EXPECT_THROW(first[3].at(name), std::out_of_range);
+
+  // inserting into an object leaves the interned names alone
+  first[0]["extra"] = true;
+  EXPECT_EQ(first[0].size(), 3);
+  EXPECT_EQ(second[0].size(), 2);
+  EXPECT_EQ(second[1].serialize(), R"({"id":2,"name":"b"})");
+
+  // 128-bit integers stay integers while they fit in 64 bits
+  first[0]["extra"] = FLZ::int128_t{42};
+  EXPECT_TRUE(first[0]["extra"].is_number_integer());
+  EXPECT_EQ(first[0]["extra"].serialize(), "42");
+  first[0]["extra"] = FLZ::int128_t{1} << 100;
+  EXPECT_TRUE(first[0]["extra"].is_number_float());
+
+  // documents outlive the caller's handle on the registry
+  shapes.reset();
+  EXPECT_EQ(second[2]["name"], "c");
+
+  auto limited = std::make_shared<XSON::ARENA::Shapes>(1);
+  auto const capped = XSON::ARENA::parse(raw, limited);
+  EXPECT_EQ(limited->size(), 1);
+  EXPECT_EQ(capped, XSON::ARENA::parse(raw));
+}
+
+TEST(XSON, StreamRejectsMalformed) {
+  auto const drain = [](std::string_view raw, size_t limit = 1024) {
+    XSON::ArrayStream stream{limit};
+    stream.feed(raw, [](std::string_view) {});
+    stream.finish();
+  };
+
+  EXPECT_NO_THROW(drain(" [ ] "));
+  for (const auto *const raw :
+       {"", "{}", "[1,]", "[,1]", "[1 2]", "[1", R"(["a)", "[1]x", "[1]]"}) {
+    EXPECT_THROW(drain(raw), std::runtime_error) << raw;
+  }
+
+  // an element larger than the limit is rejected before it completes
+  EXPECT_THROW(drain(R"([")" + std::string(64, 'x')), std::runtime_error);
+  EXPECT_THROW(drain(R"(["xxxx"])", 4), std::runtime_error);
+  EXPECT_NO_THROW(drain(R"(["xxxx"])", 6));
+
+  // only the element in progress is buffered
+  XSON::ArrayStream stream{16};
+  stream.feed("[");
+  for (int idx = 0; idx < 1000; ++idx) {
+    stream.feed(R"({"n":1},)");
+    EXPECT_TRUE(stream.next().has_value());
+  }
+  stream.feed("2]", [](std::string_view elm) { EXPECT_EQ(elm, "2"); });
+  stream.finish();
+}
+
+TEST(XSON, ParallelRejectsMalformed) {
+  exec::static_thread_pool pool{4};
+
+  EXPECT_TRUE(XSON::parse_array<XSON::ARENA>(" [ ] ", pool).empty());
+  EXPECT_TRUE(XSON::parse_ndjson<XSON::ARENA>("\n \n", pool).empty());
+
+  for (const auto *const raw :
+       {"", "{}", "[1,]", "[,1]", "[1 2]", "[1", R"(["a)", "[1]x", "[1}",
+        "[{]}", "[[}]"}) {
+    for (size_t grain : {size_t{1}, size_t{1} << 16}) {
+      EXPECT_THROW(XSON::parse_array<XSON::ARENA>(raw, pool, grain),
+                   std::runtime_error)
+          << raw;
+    }
+  }
+
+  // the error reported is the earliest in the input
+  std::string ndjson;
+  for (int idx = 0; idx < 100; ++idx)
+    ndjson += idx == 10 ? "[1,]\n" : idx == 90 ? "{\"a\"}\n" : "{}\n";
+  std::string expected;
+  try {
+    XSON::ARENA::parse("[1,]");
+  } catch (std::runtime_error const &error) {
+    expected = error.what();
+  }
+  try {
+    XSON::parse_ndjson<XSON::ARENA>(ndjson, pool, 1);
+    ADD_FAILURE();
+  } catch (std::runtime_error const &error) {
+    EXPECT_EQ(error.what(), expected);
+  }
+
+  // ... even when the split fails after publishing the run that holds it,
+  // and on a pool with a single worker
+  std::string truncated = R"([1, {"a":tru})";
+  for (int idx = 0; idx < 100; ++idx)
+    truncated += ",{}";
+  try {
+    XSON::ARENA::parse(R"({"a":tru})");
+  } catch (std::runtime_error const &error) {
+    expected = error.what();
+  }
+  exec::static_thread_pool single{1};
+  for (auto *const runner : {&pool, &single}) {
+    try {
+      XSON::parse_array<XSON::ARENA>(truncated, *runner, 1);
+      ADD_FAILURE();
+    } catch (std::runtime_error const &error) {
+      EXPECT_EQ(error.what(), expected);
+    }
+  }
+}
+
+TEST(XSON, PathExtract) {
+  const auto *const raw = R"( {
+    "skip": {"deep": [1, {"items": "decoy"}], "s": "}]\"{"},
+    "d\u0061ta": {"items": [ {"price": 1.5}, {"price": 2} , {"price": -12.5e1,
+      "tags": ["x"]} ], "n": null},
+    "tail": true } )";
+
+  EXPECT_EQ(XSON::Path{"/data/items/2/price"}.extract(raw), "-12.5e1");
+  EXPECT_EQ(XSON::Path{"/data/items/2/tags"}.extract(raw), R"(["x"])");
+  EXPECT_EQ(XSON::Path{"/skip/s"}.extract(raw), R"("}]\"{")");
+  EXPECT_EQ(XSON::Path{"/data/n"}.extract(raw), "null");
+  EXPECT_EQ(XSON::Path{"/tail"}.extract(raw), "true");
+  EXPECT_EQ(XSON::Path{"/data/items/3"}.extract(raw), std::nullopt);
+  EXPECT_EQ(XSON::Path{"/data/items/price"}.extract(raw), std::nullopt);
+  EXPECT_EQ(XSON::Path{"/items"}.extract(raw), std::nullopt);
+  EXPECT_EQ(XSON::ARENA::parse(*XSON::Path{"/data"}.extract(raw)),
+            XSON::ARENA::parse(raw)["data"]);
+
+  // several paths from one scan, in the order asked
+  std::vector<XSON::Path> const paths = {
+      XSON::Path{"/tail"}, XSON::Path{"/data/items/0/price"},
+      XSON::Path{"/data/missing"}, XSON::Path{"/data/items/2/price"},
+      XSON::Path{"/data/items/0/price"}, XSON::Path{}};
+  auto const found = XSON::Path::extract(paths, raw);
+  ASSERT_EQ(found.size(), paths.size());
+  EXPECT_EQ(found[0], "true");
+  EXPECT_EQ(found[1], "1.5");
+  EXPECT_EQ(found[2], std::nullopt);
+  EXPECT_EQ(found[3], "-12.5e1");
+  EXPECT_EQ(found[4], "1.5");
+  ASSERT_TRUE(found[5].has_value());
+  EXPECT_EQ(found[5]->front(), '{');
+
+  // malformed pointers throw, malformed text does not resolve
+  for (const auto *const bad : {"data", "/a~", "/a~2"})
+    EXPECT_THROW(XSON::Path{bad}, std::runtime_error) << bad;
+  for (const auto *const text :
+       {"", "{", R"({"a")", R"({"a" 1})", R"({"a":)", R"({"b":"x, "a":1})",
+        "[1,"}) {
+    EXPECT_EQ(XSON::Path{"/a"}.extract(text), std::nullopt) << text;
+  }
+}
+
+TEST(XSON, Columns) {
+  std::string raw = R"({"meta": {"n": 3}, "orders": [)";
+  for (int idx = 0; idx < 130; ++idx) {
+    if (idx != 0)
+      raw += ",\n";
+    raw += R"({"id":)" + std::to_string(idx) + R"(, "total":)" +
+           std::to_string(idx) + R"(.5, "name":"n)" + std::to_string(idx) +
+           R"(", "skip":{"id":"nested"}})";
+  }
+  raw += R"(, {"id": 1.5, "total": null, "name": "a\"b"}, 7,
+            {"id": 99999999999999999999, "total": "1", "name": 3},
+            {"total": -2e3, "id": -4}, {}])";
+  raw += "}";
+
+  auto const [id, total, name] = XSON::columns<int64_t, double, std::string_view>(
+      raw, XSON::Path{"/orders"}, {"id", "total", "name"});
+  ASSERT_EQ(id.size(), 135);
+  ASSERT_EQ(total.size(), 135);
+  ASSERT_EQ(name.size(), 135);
+
+  for (size_t row = 0; row < 130; ++row) {
+    ASSERT_TRUE(id.is_valid(row) && total.is_valid(row) && name.is_valid(row));
+    EXPECT_EQ(id.values[row], row);
+    EXPECT_EQ(total.values[row], row + 0.5);
+    EXPECT_EQ(name.values[row], "n" + std::to_string(row));
+  }
+
+  // a fraction is not an int64_t, an explicit null is flagged as such
+  EXPECT_FALSE(id.is_valid(130));
+  EXPECT_FALSE(total.is_valid(130));
+  EXPECT_TRUE(total.is_null(130));
+  EXPECT_EQ(name.values[130], "a\"b");
+
+  // a non-object element and mistyped or out-of-range fields
+  for (size_t row : {131, 132}) {
+    EXPECT_FALSE(id.is_valid(row) || total.is_valid(row) || name.is_valid(row));
+    EXPECT_FALSE(id.is_null(row) || total.is_null(row) || name.is_null(row));
+  }
+  EXPECT_EQ(total.values[133], -2000.0);
+  EXPECT_EQ(id.values[133], -4);
+  EXPECT_FALSE(name.is_valid(133));
+  EXPECT_FALSE(id.is_valid(134));
+
+  EXPECT_EQ(id.valid_count(), 131);
+  EXPECT_EQ(total.valid_count(), 131);
+  EXPECT_EQ(name.valid_count(), 131);
+
+  EXPECT_THROW((XSON::columns<double>(raw, XSON::Path{"/meta"}, {"n"})),
+               std::out_of_range);
+  EXPECT_THROW((XSON::columns<double>(R"({"a":[{"n":1},{"n" 2}]})",
+                                      XSON::Path{"/a"}, {"n"})),
+               std::runtime_error);
+  auto const [empty] = XSON::columns<double>("[]", XSON::Path{}, {"n"});
+  EXPECT_EQ(empty.size(), 0);
+  EXPECT_THROW((XSON::columns<double, int64_t>(raw, XSON::Path{"/orders"},
+                                               {"id", "id"})),
+               std::invalid_argument);
+
+  // a repeated member counts as its last occurrence
+  auto const [dup] = XSON::columns<int64_t>(
+      R"([{"a":1,"a":"x"}, {"a":null,"a":2}, {"a":3,"a":null}])", XSON::Path{},
+      {"a"});
+  ASSERT_EQ(dup.size(), 3);
+  EXPECT_FALSE(dup.is_valid(0) || dup.is_null(0));
+  EXPECT_EQ(dup.values[0], 0);
+  EXPECT_TRUE(dup.is_valid(1) && !dup.is_null(1));
+  EXPECT_EQ(dup.values[1], 2);
+  EXPECT_TRUE(!dup.is_valid(2) && dup.is_null(2));
+  EXPECT_EQ(dup.values[2], 0);
+
+  // string columns move, keeping unescaped values valid, but do not copy
+  static_assert(std::is_copy_constructible_v<XSON::Column<double>>);
+  static_assert(!std::is_copy_constructible_v<XSON::Column<std::string_view>>);
+  static_assert(!std::is_copy_assignable_v<XSON::Column<std::string_view>>);
+  auto [names] = XSON::columns<std::string_view>(
+      R"([{"s":"x\ty"}, {"s":"plain"}])", XSON::Path{}, {"s"});
+  auto const moved = std::move(names);
+  EXPECT_EQ(moved.values[0], "x\ty");
+  EXPECT_EQ(moved.values[1], "plain");
+}
+
 TEST(XSON, ConversionRoundTrip) {
   XSON::NLH json1;
   XSON::GLZ json2;
@@ -385,6 +955,29 @@ TEST(XSON, ConversionRoundTrip) {
   EXPECT_EQ(json1.serialize(), raw);
 }
 
+namespace {
+struct TypedRecord {
+  std::string name;
+  int64_t count = 0;
+  double ratio = 0;
+  std::vector<int> values;
+};
+} // namespace
+
+TEST(XSON, DecodeTyped) {
+  auto const decoded = XSON::decode<TypedRecord>(
+      R"({"name":"abc","count":42,"ratio":0.5,"values":[1,2,3],"ignored":{}})");
+
+  ASSERT_TRUE(decoded.has_value()) << decoded.error().what();
+  EXPECT_EQ(decoded->name, "abc");
+  EXPECT_EQ(decoded->count, 42);
+  EXPECT_EQ(decoded->ratio, 0.5);
+  EXPECT_EQ(decoded->values, (std::vector<int>{1, 2, 3}));
+
+  EXPECT_FALSE(XSON::decode<TypedRecord>(R"({"name":42})").has_value());
+  EXPECT_FALSE(XSON::decode<TypedRecord>(R"({"name":"abc")").has_value());
+}
+
 int main(int argc, char **argv) {
   ::cpptrace::register_terminate_handler();
   ::testing::InitGoogleTest(&argc, argv);
@@ -0,0 +1,120 @@
+/**
+ *  @brief  falutez-zdict - train a zstd dictionary for the `zstd-dict`
+ *          content coding from recorded traffic
+ *
+ *  Input files hold one record per line, as produced by `RequestSpec::str()`
+ *  or `ResponseDetails::str()`; the "body" field of every record is used as a
+ *  training sample. The resulting dictionary is meant to be loaded on both
+ *  ends (`HTTP::CODEC::ZstdDictionary{bytes}` on the client side).
+ *
+ *  usage: falutez-zdict [-o out.dict] [-s max-dict-bytes] records...
+ */
+
+#include <charconv>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <falutez/falutez-codec.hpp>
+#include <falutez/falutez-serio.hpp>
+
+int main(int argc, char **argv) {
+  std::string out_path = "falutez.dict";
+  size_t capacity = HTTP::CODEC::ZstdDictionary::kDefaultCapacity;
+  std::vector<std::string> inputs;
+
+  for (int idx = 1; idx < argc; ++idx) {
+    auto const arg = std::string_view{argv[idx]};
+    if (arg == "-o" && idx + 1 < argc) {
+      out_path = argv[++idx];
+    } else if (arg == "-s" && idx + 1 < argc) {
+      auto const value = std::string_view{argv[++idx]};
+      if (std::from_chars(value.data(), value.data() + value.size(), capacity)
+              .ec != std::errc{}) {
+        std::cerr << std::format("invalid dictionary size: {}\n", value);
+        return 1;
+      }
+    } else if (arg == "-h" || arg == "--help") {
+      std::cerr << std::format(
+          "usage: {} [-o out.dict] [-s max-dict-bytes] records...\n", argv[0]);
+      return 0;
+    } else {
+      inputs.emplace_back(arg);
+    }
+  }
+
+  if (inputs.empty()) {
+    std::cerr << std::format(
+        "usage: {} [-o out.dict] [-s max-dict-bytes] records...\n", argv[0]);
+    return 1;
+  }
+
+  std::vector<std::string> bodies;
+  size_t skipped = 0;
+
+  for (auto const &input : inputs) {
+    std::ifstream ifs{input};
+    if (!ifs) {
+      std::cerr << std::format("cannot open {}\n", input);
+      return 1;
+    }
+
+    for (std::string line; std::getline(ifs, line);) {
+      if (line.empty())
+        continue;
+      try {
+        auto const record = XSON::JSON::parse(line);
+        if (record.has_string_field("body") &&
+            !record.at("body").get_string().empty())
+          bodies.emplace_back(record.at("body").get_string());
+        else
+          ++skipped;
+      } catch (std::exception const &e) {
+        ++skipped;
+      }
+    }
+  }
+
+  auto const samples =
+      std::vector<std::string_view>{bodies.begin(), bodies.end()};
+
+  auto dictionary = HTTP::CODEC::ZstdDictionary::train(samples, capacity);
+
+  if (!dictionary.has_value()) {
+    std::cerr << std::format("training failed on {} samples: {}\n",
+                             samples.size(), dictionary.error().str());
+    return 1;
+  }
+
+  std::ofstream ofs{out_path, std::ios::binary};
+  ofs.write(dictionary->bytes().data(),
+            static_cast<std::streamsize>(dictionary->bytes().size()));
+  if (!ofs) {
+    std::cerr << std::format("cannot write {}\n", out_path);
+    return 1;
+  }
+
+  // report what the dictionary buys on the training set itself
+  size_t raw_total = 0;
+  size_t plain_total = 0;
+  size_t dict_total = 0;
+  for (auto const sample : samples) {
+    raw_total += sample.size();
+    plain_total +=
+        HTTP::CODEC::compress(HTTP::ENCODING::ZSTD, sample).value().size();
+    dict_total += HTTP::CODEC::compress(HTTP::ENCODING::ZSTD_DICT, sample,
+                                        HTTP::CompressionConfig::kDefaultLevel,
+                                        &dictionary.value())
+                      .value()
+                      .size();
+  }
+
+  std::cout << std::format(
+      "dictionary id={} size={} -> {}\n"
+      "samples={} (skipped {}) raw={} zstd={} zstd-dict={}\n",
+      dictionary->id(), dictionary->bytes().size(), out_path, samples.size(),
+      skipped, raw_total, plain_total, dict_total);
+
+  return 0;
+}